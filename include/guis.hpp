@@ -1,9 +1,81 @@
 #pragma once
 
+#include "input.hpp"
+#include "output.hpp"
+
 #include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace sss::guis
 {
+    /**
+     * @brief Severity of messages written to a debug stream (ordered from least to most verbose)
+     */
+    enum class log_level_t
+    {
+        none,
+        error,
+        warning,
+        info,
+        debug
+    };
+
+    /**
+     * @brief Options for generating GUIs
+     */
+    struct generation_options_t
+    {
+        /**
+         * @brief Do not allow dependencies or generated file to have conflicting output file name
+         */
+        bool disallow_conflicts = true;
+        /**
+         * @brief Whether to flatten dependency output files to just their filename (no directory hierarchy)
+         */
+        bool flatten_dependency_references = false;
+        /**
+         * @brief A `std::ofstream` to write debug outputs to
+         */
+        std::ostream const *debug_stream = nullptr;
+        /**
+         * @brief The most verbose level of message to write to `debug_stream`
+         */
+        log_level_t log_level = log_level_t::debug;
+        /**
+         * @brief Whether to generate a service worker that precaches every published file (keyed by content hash)
+         */
+        bool service_worker = false;
+        /**
+         * @brief The file to write a JSON report of the payload of each GUI to (if empty then no report is written, and a batch uses the report file of each entry instead)
+         */
+        std::filesystem::path report_file = {};
+        /**
+         * @brief The URL that each GUI sends its recorded runtime timings to once loaded (if empty then timings are not sent)
+         */
+        std::string telemetry_endpoint = {};
+    };
+
+    /**
+     * @brief A configuration file to generate GUIs from as part of a batch
+     */
+    struct batch_entry_t
+    {
+        /**
+         * @brief The source configuration file to find structures in
+         */
+        std::filesystem::path configuration_file;
+        /**
+         * @brief The output directory for all generated file
+         */
+        std::filesystem::path output_directory;
+        /**
+         * @brief The file to write a JSON report of the payload of each GUI to (if empty then no report is written)
+         */
+        std::filesystem::path report_file = {};
+    };
+
     class guis_t
     {
     private:
@@ -12,28 +84,61 @@ namespace sss::guis
          */
         std::filesystem::path const m_configuration_directory;
         /**
-         * @brief The source configuration file to find structures in
+         * @brief Output owned by this generator (when constructed with an output directory)
+         */
+        std::unique_ptr<output_t> const m_owned_output;
+        /**
+         * @brief The output to write all generated file to
          */
-        std::filesystem::path const m_output_directory;
+        output_t &m_output;
+        /**
+         * @brief Input owned by this generator (when no input is given)
+         */
+        std::unique_ptr<input_t> const m_owned_input;
+        /**
+         * @brief The input to read all source files from
+         */
+        input_t const &m_input;
+        /**
+         * @brief The directory to persist parsed configuration files in (if empty then nothing is cached)
+         */
+        std::filesystem::path const m_cache_directory;
 
     public:
         /**
          * @brief Construct a GUI generator
          * @param configuration_file The source configuration file to find structures in
          * @param output_directory The output directory for all generated file
+         * @param cache_directory The directory to persist parsed configuration files in between runs (if empty then nothing is cached)
+         * @param input The input to read all source files from, such as `memory_input_t` (if `nullptr` then the filesystem is used)
          */
-        guis_t(std::filesystem::path const &configuration_file, std::filesystem::path const &output_directory);
+        guis_t(std::filesystem::path const &configuration_file, std::filesystem::path const &output_directory, std::filesystem::path const &cache_directory = {}, input_t const *input = nullptr);
+        /**
+         * @brief Construct a GUI generator that writes to a custom output (such as `memory_output_t`)
+         * @param configuration_file The source configuration file to find structures in
+         * @param output The output to write all generated file to (must outlive the generator)
+         * @param cache_directory The directory to persist parsed configuration files in between runs (if empty then nothing is cached)
+         * @param input The input to read all source files from, such as `memory_input_t` (if `nullptr` then the filesystem is used)
+         */
+        guis_t(std::filesystem::path const &configuration_file, output_t &output, std::filesystem::path const &cache_directory = {}, input_t const *input = nullptr);
         /**
          * @brief Deconstructor
          */
         ~guis_t();
         /**
          * @brief Generate GUIs
-         * @param disallow_conflicts Do not allow dependencies or generated file to have conflicting output file name
-         * @param flatten_dependency_references Whether to flatten dependency output files to just their filename (no directory hierarchy)
-         * @param debug_stream A `std::ofstream` to write debug outputs to
+         * @param options How to generate the GUIs
+         */
+        void generate(generation_options_t const &options = {});
+        /**
+         * @brief Generate GUIs for many configuration files in one process (parsed configuration files are shared between them)
+         * @param entries The configuration files to generate GUIs from, and where to output them
+         * @param cache_directory The directory to persist parsed configuration files in between runs (if empty then nothing is persisted)
+         * @param input The input to read all source files from, such as `memory_input_t` (if `nullptr` then the filesystem is used)
+         * @param options How to generate the GUIs of every entry
+         * @throw std::runtime_error If any entry fails (after every other entry has been generated)
          */
-        void generate(bool const disallow_conflicts = true, bool const flatten_dependency_references = false, std::ostream const *debug_stream = nullptr);
+        static void generate_batch(std::vector<batch_entry_t> const &entries, std::filesystem::path const &cache_directory = {}, input_t const *input = nullptr, generation_options_t const &options = {});
     };
     extern guis_t guis;
 }
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sss::guis
+{
+    /**
+     * @brief Metadata of a path provided by an input
+     */
+    struct input_status_t
+    {
+        /**
+         * @brief Whether anything exists at the path
+         */
+        bool exists;
+        /**
+         * @brief Whether the path is a directory
+         */
+        bool directory;
+        /**
+         * @brief Size of the file (in bytes)
+         */
+        std::uintmax_t size;
+        /**
+         * @brief Modification time of the file (only compared for equality)
+         */
+        std::int64_t modification_time;
+    };
+
+    /**
+     * @brief Source of configurations, widget configurations, stylesheets, modules, and dependencies
+     */
+    class input_t
+    {
+    public:
+        /**
+         * @brief Deconstructor
+         */
+        virtual ~input_t() = default;
+        /**
+         * @brief Get the metadata of a path
+         * @param path The absolute path to check
+         * @return Metadata of the path
+         */
+        virtual input_status_t status(std::filesystem::path const &path) const = 0;
+        /**
+         * @brief Read the contents of a file
+         * @param path The absolute path of the file
+         * @return Contents of the file
+         */
+        virtual std::string read(std::filesystem::path const &path) const = 0;
+        /**
+         * @brief List all files within a directory (recursively)
+         * @param directory The absolute path of the directory
+         * @return Absolute paths of all files
+         */
+        virtual std::vector<std::filesystem::path> list(std::filesystem::path const &directory) const = 0;
+        /**
+         * @brief Resolve a path to its canonical form (the path does not need to exist)
+         * @param path The path to resolve
+         * @return Canonical path
+         */
+        virtual std::filesystem::path canonical(std::filesystem::path const &path) const = 0;
+        /**
+         * @brief Whether paths of this input refer to the real filesystem (allowing files to be copied by path)
+         * @return Whether paths refer to the real filesystem
+         */
+        virtual bool native() const = 0;
+    };
+
+    /**
+     * @brief Reads everything from the filesystem
+     */
+    class filesystem_input_t : public input_t
+    {
+    public:
+        /**
+         * @brief Construct a filesystem input
+         */
+        filesystem_input_t();
+        input_status_t status(std::filesystem::path const &path) const override;
+        std::string read(std::filesystem::path const &path) const override;
+        std::vector<std::filesystem::path> list(std::filesystem::path const &directory) const override;
+        std::filesystem::path canonical(std::filesystem::path const &path) const override;
+        bool native() const override;
+    };
+
+    /**
+     * @brief Reads everything from files held in memory
+     */
+    class memory_input_t : public input_t
+    {
+    private:
+        /**
+         * @brief Guards `m_files`
+         */
+        mutable std::mutex m_mutex;
+        /**
+         * @brief Files (by absolute path) and their contents
+         */
+        std::map<std::filesystem::path, std::string> m_files;
+
+    public:
+        /**
+         * @brief Construct an in-memory input
+         */
+        memory_input_t();
+        /**
+         * @brief Add (or replace) a file
+         * @param path The path of the file (relative paths are made absolute against the current directory)
+         * @param contents The contents of the file
+         */
+        void add(std::filesystem::path const &path, std::string const &contents);
+        input_status_t status(std::filesystem::path const &path) const override;
+        std::string read(std::filesystem::path const &path) const override;
+        std::vector<std::filesystem::path> list(std::filesystem::path const &directory) const override;
+        std::filesystem::path canonical(std::filesystem::path const &path) const override;
+        bool native() const override;
+    };
+
+    /**
+     * @brief Remembers the metadata, canonical paths, and directory listings of another input (for the length of a run, as changes are never noticed)
+     */
+    class caching_input_t : public input_t
+    {
+    private:
+        /**
+         * @brief The input being cached
+         */
+        input_t const &m_input;
+        /**
+         * @brief Guards the cached results
+         */
+        mutable std::mutex m_mutex;
+        /**
+         * @brief Metadata of paths
+         */
+        mutable std::map<std::filesystem::path, input_status_t> m_statuses;
+        /**
+         * @brief Canonical forms of paths
+         */
+        mutable std::map<std::filesystem::path, std::filesystem::path> m_canonical_paths;
+        /**
+         * @brief Files within directories
+         */
+        mutable std::map<std::filesystem::path, std::vector<std::filesystem::path>> m_listings;
+
+    public:
+        /**
+         * @brief Construct a caching input
+         * @param input The input to cache (must outlive the caching input)
+         */
+        explicit caching_input_t(input_t const &input);
+        input_status_t status(std::filesystem::path const &path) const override;
+        std::string read(std::filesystem::path const &path) const override;
+        std::vector<std::filesystem::path> list(std::filesystem::path const &directory) const override;
+        std::filesystem::path canonical(std::filesystem::path const &path) const override;
+        bool native() const override;
+    };
+}
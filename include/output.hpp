@@ -0,0 +1,211 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace sss::guis
+{
+    /**
+     * @brief Destination of generated files and dependencies
+     */
+    class output_t
+    {
+    public:
+        /**
+         * @brief Deconstructor
+         */
+        virtual ~output_t() = default;
+        /**
+         * @brief Prepare the output to receive files (called once before anything is written)
+         */
+        virtual void open() = 0;
+        /**
+         * @brief Complete the output (called once after everything has been written)
+         */
+        virtual void close() = 0;
+        /**
+         * @brief Check whether a file already exists within the output
+         * @param path The path within the output
+         * @return Whether the file exists
+         */
+        virtual bool exists(std::filesystem::path const &path) const = 0;
+        /**
+         * @brief List every path that already exists within the output (allows checking many paths at once)
+         * @return Paths within the output
+         */
+        virtual std::vector<std::filesystem::path> listing() const = 0;
+        /**
+         * @brief Write a generated file (may be called concurrently)
+         * @param path The path within the output
+         * @param contents The contents of the file
+         */
+        virtual void write(std::filesystem::path const &path, std::string const &contents) = 0;
+        /**
+         * @brief Add a dependency to the output
+         * @param source The absolute path of the source file or directory
+         * @param path The path within the output
+         * @param overwrite Whether to replace files already in the output (otherwise an existing file is an error)
+         */
+        virtual void copy(std::filesystem::path const &source, std::filesystem::path const &path, bool const overwrite) = 0;
+    };
+
+    /**
+     * @brief Writes all output files into a directory
+     */
+    class directory_output_t : public output_t
+    {
+    private:
+        /**
+         * @brief The output directory for all generated file
+         */
+        std::filesystem::path const m_directory;
+
+    public:
+        /**
+         * @brief Construct a directory output
+         * @param directory The output directory for all generated file
+         */
+        directory_output_t(std::filesystem::path const &directory);
+        void open() override;
+        void close() override;
+        bool exists(std::filesystem::path const &path) const override;
+        std::vector<std::filesystem::path> listing() const override;
+        void write(std::filesystem::path const &path, std::string const &contents) override;
+        void copy(std::filesystem::path const &source, std::filesystem::path const &path, bool const overwrite) override;
+    };
+
+    /**
+     * @brief Keeps all generated files in memory (dependencies are kept as references to their source files)
+     */
+    class memory_output_t : public output_t
+    {
+    private:
+        /**
+         * @brief Guards the collections during concurrent writes
+         */
+        mutable std::mutex m_mutex;
+        /**
+         * @brief Generated files and their contents
+         */
+        std::map<std::filesystem::path, std::string> m_files;
+        /**
+         * @brief Dependencies and the source files they refer to
+         */
+        std::map<std::filesystem::path, std::filesystem::path> m_dependencies;
+
+    public:
+        /**
+         * @brief Construct an in-memory output
+         */
+        memory_output_t();
+        void open() override;
+        void close() override;
+        bool exists(std::filesystem::path const &path) const override;
+        std::vector<std::filesystem::path> listing() const override;
+        void write(std::filesystem::path const &path, std::string const &contents) override;
+        void copy(std::filesystem::path const &source, std::filesystem::path const &path, bool const overwrite) override;
+        /**
+         * @brief Get the generated files
+         * @return Paths within the output and their contents
+         */
+        std::map<std::filesystem::path, std::string> const &files() const;
+        /**
+         * @brief Get the dependencies
+         * @return Paths within the output and the absolute path of the source file they refer to
+         */
+        std::map<std::filesystem::path, std::filesystem::path> const &dependencies() const;
+    };
+
+    /**
+     * @brief Streams all output files into a single tar archive (optionally gzip compressed)
+     */
+    class archive_output_t : public output_t
+    {
+    private:
+        /**
+         * @brief Compression state (only present when compressing)
+         */
+        struct compressor_t;
+        /**
+         * @brief Guards the stream during concurrent writes
+         */
+        mutable std::mutex m_mutex;
+        /**
+         * @brief The archive file being written (when not writing to a given stream)
+         */
+        std::filesystem::path const m_file;
+        /**
+         * @brief The archive file stream (when not writing to a given stream)
+         */
+        std::unique_ptr<std::ofstream> m_file_stream;
+        /**
+         * @brief The stream the archive is written to
+         */
+        std::ostream &m_stream;
+        /**
+         * @brief Compression state (`nullptr` if not compressing)
+         */
+        std::unique_ptr<compressor_t> m_compressor;
+        /**
+         * @brief Paths of all entries within the archive
+         */
+        std::set<std::filesystem::path> m_entries;
+        /**
+         * @brief Modification time given to all entries
+         */
+        long long const m_time;
+        /**
+         * @brief Whether the archive has been completed
+         */
+        bool m_closed;
+        /**
+         * @brief Write raw archive bytes (compressing if required)
+         * @param data The bytes to write
+         * @param size The amount of bytes
+         * @param finish Whether this completes the archive
+         */
+        void emit(char const *data, std::size_t const size, bool const finish = false);
+        /**
+         * @brief Write the header of an entry
+         * @param path The path within the archive
+         * @param size The size of the entry
+         */
+        void header(std::filesystem::path const &path, std::uintmax_t const size);
+        /**
+         * @brief Pad an entry to a whole block
+         * @param size The size of the entry
+         */
+        void pad(std::uintmax_t const size);
+
+    public:
+        /**
+         * @brief Construct an archive output that writes to a file (the file only appears once the archive is complete)
+         * @param file The location of the archive
+         * @param compress Whether to gzip compress the archive
+         */
+        archive_output_t(std::filesystem::path const &file, bool const compress = false);
+        /**
+         * @brief Construct an archive output that writes to a stream (such as `std::cout`)
+         * @param stream The stream to write the archive to
+         * @param compress Whether to gzip compress the archive
+         */
+        archive_output_t(std::ostream &stream, bool const compress = false);
+        /**
+         * @brief Deconstructor (removes an incomplete archive file)
+         */
+        ~archive_output_t();
+        void open() override;
+        void close() override;
+        bool exists(std::filesystem::path const &path) const override;
+        std::vector<std::filesystem::path> listing() const override;
+        void write(std::filesystem::path const &path, std::string const &contents) override;
+        void copy(std::filesystem::path const &source, std::filesystem::path const &path, bool const overwrite) override;
+    };
+}
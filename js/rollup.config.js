@@ -24,6 +24,20 @@ const jsBundleConfig = {
     ],
 };
 
+const serviceWorkerBundleConfig = {
+    input: "ts/serviceWorker.ts",
+    output: {
+        file: `dist/${bundleName}.service-worker.js`,
+        format: "iife",
+        sourcemap: false,
+    },
+    plugins: [
+        resolve(),
+        typescript(),
+        terser(),
+    ],
+};
+
 const dtsBundleConfig = {
     input: "dist/types/exported.d.ts",
     output: [{
@@ -35,4 +49,4 @@ const dtsBundleConfig = {
     ],
 };
 
-export default [jsBundleConfig, dtsBundleConfig];
+export default [jsBundleConfig, serviceWorkerBundleConfig, dtsBundleConfig];
@@ -2,12 +2,14 @@ import { alert } from "./modals/alert";
 import { confirm } from "./modals/confirm";
 import { dialog } from "./modals/dialog";
 import { loadModule } from "./resources/module";
-import { loadResource, multimediaResource_t } from "./resources/resource";
+import { loadResource, multimediaResource_t, prefetchResource, releaseResource, resourceOptions_t, setResourceConcurrency, setResourceMemoryBudget } from "./resources/resource";
+import { resourcePriority_t } from "./resources/scheduler";
 import { loadStylesheet } from "./resources/stylesheet";
 import { structure_t, widgetIdentifier_t } from "./structure";
+import { timing_t, timings } from "./telemetry";
 import { widget_t } from "./widgets/widget";
 
-export { alert, confirm, dialog, loadModule, loadResource, multimediaResource_t, loadStylesheet, widget_t, widgetIdentifier_t};
+export { alert, confirm, dialog, loadModule, loadResource, multimediaResource_t, loadStylesheet, prefetchResource, releaseResource, resourceOptions_t, resourcePriority_t, setResourceConcurrency, setResourceMemoryBudget, timing_t, widget_t, widgetIdentifier_t};
 
 /**
  * Declare a widget type that applies to a factory that can be created from a structure
@@ -33,6 +35,13 @@ export function structureWidget(identifier: widgetIdentifier_t): widget_t {
 export function structureWidgetExists(identifier: widgetIdentifier_t): boolean {
     return structure_t.widgetExists(identifier);
 }
+/**
+ * Get the timings recorded by the GUI, such as module loads, structure fetch and parse, and the configuration and render of each widget
+ * @returns {timing_t[]} Recorded timings in the order they started
+ */
+export function telemetryTimings(): timing_t[] {
+    return timings();
+}
 /**
  * Exports functions to window
  * @internal
@@ -41,10 +50,16 @@ export function exportToWindow(): void {
     (window as any).structureDeclareWidget = structureDeclareWidget;
     (window as any).structureWidget = structureWidget;
     (window as any).structureWidgetExists = structureWidgetExists;
+    (window as any).telemetryTimings = telemetryTimings;
     (window as any).widget_t = widget_t;
     (window as any).loadStylesheet = loadStylesheet;
     (window as any).loadModule = loadModule;
     (window as any).loadResource = loadResource;
+    (window as any).prefetchResource = prefetchResource;
+    (window as any).releaseResource = releaseResource;
+    (window as any).setResourceConcurrency = setResourceConcurrency;
+    (window as any).setResourceMemoryBudget = setResourceMemoryBudget;
+    (window as any).resourcePriority_t = resourcePriority_t;
     (window as any).alert = alert;
     (window as any).confirm = confirm;
     (window as any).dialog = dialog;
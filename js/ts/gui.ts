@@ -1,3 +1,25 @@
+/**
+ * Interface for the hot update configuration of a GUI
+ * @internal
+ */
+export interface hotUpdate_t {
+    /**
+     * The path to the update manifest (polled for new versions of the structure)
+     * @internal
+     */
+    manifest: string;
+    /**
+     * Seconds between checks of the update manifest
+     * @internal
+     */
+    interval: number;
+    /**
+     * The version of the structure that the GUI was generated with
+     * @internal
+     */
+    version: string;
+}
+
 /**
  * Interface for the GUI configuration
  * @internal
@@ -24,6 +46,26 @@ interface gui_schema_t {
      * @internal
      */
     stylesheet: string;
+    /**
+     * The path to the service worker to register (if generated)
+     * @internal
+     */
+    serviceWorker?: string;
+    /**
+     * The endpoint to send recorded timings to once the GUI has loaded (if enabled)
+     * @internal
+     */
+    telemetry?: string;
+    /**
+     * How the GUI checks for new versions of its structure (if enabled)
+     * @internal
+     */
+    update?: hotUpdate_t;
+    /**
+     * Whether media widgets render placeholders that their media fills in once loaded (if enabled)
+     * @internal
+     */
+    progressive?: boolean;
 }
 
 /**
@@ -57,6 +99,26 @@ export class gui_t {
      * @internal
      */
     public stylesheet!: string;
+    /**
+     * The path to the service worker to register (if generated)
+     * @internal
+     */
+    public serviceWorker: (string | null) = null;
+    /**
+     * The endpoint to send recorded timings to once the GUI has loaded (if enabled)
+     * @internal
+     */
+    public telemetry: (string | null) = null;
+    /**
+     * How the GUI checks for new versions of its structure (if enabled)
+     * @internal
+     */
+    public update: (hotUpdate_t | null) = null;
+    /**
+     * Whether media widgets render placeholders that their media fills in once loaded
+     * @internal
+     */
+    public progressive: boolean = false;
     constructor() {
         if (typeof gui === "undefined") {
             throw new Error("No GUI configuration was declared");
@@ -65,5 +127,9 @@ export class gui_t {
         this.name = gui.name;
         this.structure = gui.structure
         this.stylesheet = gui.stylesheet;
+        this.serviceWorker = gui.serviceWorker ?? null;
+        this.telemetry = gui.telemetry ?? null;
+        this.update = gui.update ?? null;
+        this.progressive = gui.progressive ?? false;
     }
 }
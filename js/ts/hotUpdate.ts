@@ -0,0 +1,117 @@
+import { hotUpdate_t } from "./gui";
+import { structure_t } from "./structure";
+import { decodedStructure_t, decodeStructureInWorker, mergeStructureDelta } from "./structureDecoder";
+import { spanAsync } from "./telemetry";
+
+/**
+ * Interface for the update manifest (rewritten by the generator on every run)
+ * @internal
+ */
+interface updateManifest_t {
+    /**
+     * The version of the latest structure
+     * @internal
+     */
+    version: string;
+    /**
+     * The path to the latest structure
+     * @internal
+     */
+    structure: string;
+    /**
+     * Changes from the previous structure (if the generator knew it)
+     * @internal
+     */
+    delta?: {
+        /**
+         * The version that the delta applies to
+         * @internal
+         */
+        base: string;
+        /**
+         * The path to the delta
+         * @internal
+         */
+        file: string;
+    };
+}
+
+/**
+ * Fetch a file as text
+ * @async
+ * @param {string} path The path of the file
+ * @param {RequestInit} init Options of the request
+ * @returns {Promise<string>} The contents of the file
+ * @internal
+ */
+async function fetchText(path: string, init: RequestInit = {}): Promise<string> {
+    const response: Response = await fetch(path, init);
+    if (!response.ok) {
+        throw new Error(`Failed to fetch "${path}" (status ${response.status})`);
+    }
+    return response.text();
+}
+
+/**
+ * Get the latest structure, applying its delta to the current structure where possible instead of fetching it whole
+ * @async
+ * @param {updateManifest_t} manifest The update manifest
+ * @param {string} version The version of the current structure
+ * @returns {Promise<decodedStructure_t>} The latest structure
+ * @internal
+ */
+async function latestStructure(manifest: updateManifest_t, version: string): Promise<decodedStructure_t> {
+    if (manifest.delta !== undefined && manifest.delta.base === version) {
+        try {
+            const merged: string = mergeStructureDelta(structure_t.current(), version, await fetchText(manifest.delta.file));
+            return await decodeStructureInWorker(new TextEncoder().encode(merged).buffer);
+        } catch (error: any) {
+            console.warn(`Failed to apply the structure delta, so fetching the whole structure: ${error}`);
+        }
+    }
+    return decodeStructureInWorker(new TextEncoder().encode(await fetchText(manifest.structure)).buffer);
+}
+
+/**
+ * Check the update manifest periodically (and whenever the GUI is shown again or comes back online), updating the GUI in place when its structure changes
+ *
+ * Only the widgets whose configuration changed are rendered again; if the update cannot be applied in place the GUI is reloaded instead
+ * @param {hotUpdate_t} update How the GUI checks for new versions of its structure
+ * @internal
+ */
+export function watchForUpdates(update: hotUpdate_t): void {
+    let version: string = update.version;
+    let checking: boolean = false;
+    const check = async (): Promise<void> => {
+        if (checking || document.visibilityState === "hidden") {
+            return;
+        }
+        checking = true;
+        let manifest!: updateManifest_t;
+        let structure!: decodedStructure_t;
+        try {
+            manifest = JSON.parse(await fetchText(update.manifest, { "cache": "no-store" }));
+            if (manifest.version === version) {
+                checking = false;
+                return;
+            }
+            structure = await spanAsync("update:fetch", () => latestStructure(manifest, version));
+        } catch (error: any) {
+            // Unreachable or part way through a deployment, so check again later
+            console.warn(`Failed to check for an update of the GUI: ${error}`);
+            checking = false;
+            return;
+        }
+        try {
+            await spanAsync("update:render", () => structure_t.update(structure));
+            version = manifest.version;
+            checking = false;
+        } catch (error: any) {
+            console.warn(`Failed to update the GUI in place, so reloading it: ${error}`);
+            location.reload();
+        }
+    };
+    window.setInterval(check, update.interval * 1000);
+    document.addEventListener("visibilitychange", check);
+    window.addEventListener("online", check);
+}
@@ -7,11 +7,14 @@ import { widget_t } from "./widgets/widget";
 import { loadStylesheet } from "./resources/stylesheet";
 import { registerCoreWidgets } from "./coreWidgets";
 import { exportToWindow } from "./exported";
+import { watchForUpdates } from "./hotUpdate";
 import { loadModule, loadModules } from "./resources/module";
+import { beacon, measure, span } from "./telemetry";
 
 // @internal
 async function main(): Promise<void> {
     // Splash screen
+    const splashStart: number = performance.now();
     const splashContainer: HTMLBodyElement = document.createElement("body");
     const splashShadowRoot: ShadowRoot = splashContainer.attachShadow({ "mode": "closed" });
     const noInheritedStyling: CSSStyleSheet = new CSSStyleSheet();
@@ -22,14 +25,22 @@ async function main(): Promise<void> {
     splashHeading.innerText = "SSS";
     const splashStatus: HTMLParagraphElement = document.createElement("p");
     splashStatus.innerText = "Loading...";
+    // Main widget pre-rendered by the generator (shown instead of the splash screen whilst loading)
+    const prerendered: (Element | null) = document.body.querySelector(":scope > [prerendered]");
     const setError = (error: string): void => {
+        if (!splashContainer.isConnected) {
+            document.body.replaceWith(splashContainer);
+        }
         splashStatus.innerText = error;
         document.title = "Error | SSS";
     };
     splashContent.appendChild(splashHeading);
     splashContent.appendChild(splashStatus);
     splashShadowRoot.appendChild(splashContent);
-    document.body.replaceWith(splashContainer);
+    if (prerendered === null) {
+        document.body.replaceWith(splashContainer);
+    }
+    measure("splash", splashStart);
     exportToWindow();
     registerCoreWidgets();
     await new Promise<void>(async (resolve, reject) => {
@@ -41,31 +52,47 @@ async function main(): Promise<void> {
             reject(error);
         }
         try {
-            // Start loading stylesheet
+            if (gui_data!.serviceWorker !== null && "serviceWorker" in navigator) {
+                // Serve published files from the precache on later visits (failing to register does not affect this visit)
+                navigator.serviceWorker.register(gui_data!.serviceWorker).catch((error: any) => {
+                    console.warn(`Failed to register service worker: ${error}`);
+                });
+            }
+            widget_t.progressive = gui_data!.progressive;
+            // Start loading the stylesheet, modules, and structure at once
             const stylesheet: Promise<void> = loadStylesheet(gui_data!.stylesheet);
-            // Load modules
-            splashStatus.innerText = "Loading modules...";
             gui_data!.modules.map(module => loadModule(module));
-            await loadModules();
-            // Load layouts
+            const modules: Promise<void> = loadModules();
+            structure_t.deferUntil(modules); // Only widgets of types declared by modules wait for the modules
             splashStatus.innerText = "Loading layout...";
-            await Promise.all([structure_t.generate(gui_data!.structure), stylesheet]).then((main: (void | widget_t)[]) => {
-                if (main[0] instanceof widget_t) {
-                    splashStatus.innerText = "Rending layout...";
-                    main[0].render().then((mainElement: HTMLElement) => {
-                        while (document.body.children.length > 0) {
-                            document.body.removeChild(document.body.children[0]);
-                        }
-                        document.documentElement.replaceChild(document.createElement("body"), splashContainer);
-                        document.body.appendChild(mainElement);
-                        document.title = gui_data!.name.trim() + " | SSS";
-                        document.dispatchEvent(new Event("load"));
-                        resolve();
-                    }).catch((error) => {
-                        reject(error);
-                    });
+            const rendered: Promise<HTMLElement> = structure_t.generate(gui_data!.structure, prerendered).then((main: widget_t) => {
+                splashStatus.innerText = "Rending layout...";
+                return main.render();
+            });
+            await Promise.all([rendered, stylesheet, modules]).then(([mainElement]) => {
+                span("commit", () => {
+                    if (splashContainer.isConnected) {
+                        // Assembled apart from the document, so the splash screen is replaced in one step
+                        const body: HTMLBodyElement = document.createElement("body");
+                        body.appendChild(mainElement);
+                        document.documentElement.replaceChild(body, splashContainer);
+                    } else if (mainElement !== prerendered) {
+                        document.body.replaceChildren(mainElement);
+                    }
+                });
+                measure("ready", 0); // Since navigation started
+                document.title = gui_data!.name.trim() + " | SSS";
+                document.dispatchEvent(new Event("load"));
+                if (gui_data!.telemetry !== null) {
+                    beacon(gui_data!.telemetry, gui_data!.name);
+                }
+                if (gui_data!.update !== null) {
+                    watchForUpdates(gui_data!.update);
                 }
-            })
+                resolve();
+            }).catch((error) => {
+                reject(error);
+            });
         } catch (error: any) {
             reject(error);
         }
@@ -1,4 +1,4 @@
-import { loadResource, multimediaResource_t } from "./resource";
+import { spanAsync } from "../telemetry";
 
 /**
  * Collection of modules with associated promises
@@ -13,6 +13,8 @@ var modulesLoaded: number = 0;
 
 /**
  * Asynchronously load a module
+ *
+ * The module is linked by its own location (rather than through a blob), so that its relative imports resolve and any copy that the HTML file preloaded is reused
  * @async
  * @param {string} url The location of the module
  * @returns {Promise<void>} Success of the loading of the module
@@ -21,24 +23,19 @@ export function loadModule(url: string): Promise<void> {
     if (url in modules) {
         return modules[url];
     }
-    let module: Promise<void> = new Promise<void>((resolve, reject) => {
-        const failure = (): void => {
-            reject(`Failed to load module: ${url}`);
-        }
-        loadResource(url).then((resource: multimediaResource_t) => {
-            const module: HTMLScriptElement = document.createElement("script");
-            module.type = "module"
-            module.src = resource.blobUrl;
-            module.crossOrigin = "anonymous";
-            module.async = true;
-            module.onload = () => {
-                modulesLoaded++;
-                resolve();
-            };
-            module.onerror = () => failure();
-            document.head.appendChild(module);
-        });
-    });
+    let module: Promise<void> = spanAsync(`module:${url}`, () => new Promise<void>((resolve, reject) => {
+        const module: HTMLScriptElement = document.createElement("script");
+        module.type = "module"
+        module.src = url;
+        module.crossOrigin = "anonymous";
+        module.async = true;
+        module.onload = () => {
+            modulesLoaded++;
+            resolve();
+        };
+        module.onerror = () => reject(`Failed to load module: ${url}`);
+        document.head.appendChild(module);
+    }));
     modules[url] = module;
     return module;
 }
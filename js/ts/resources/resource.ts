@@ -1,3 +1,5 @@
+import { resourcePriority_t, scheduledTask_t, scheduler_t } from "./scheduler";
+
 /**
  * Interface for the multimedia resource
  */
@@ -13,40 +15,262 @@ export interface multimediaResource_t {
 }
 
 /**
- * Collection of resources with associated promises
+ * Interface for the options of loading a resource
+ */
+export interface resourceOptions_t {
+    /**
+     * The priority to fetch the resource with (visible by default)
+     */
+    priority?: resourcePriority_t;
+    /**
+     * Signal that withdraws interest in the resource (the fetch is aborted once nothing else is interested)
+     */
+    signal?: AbortSignal;
+    /**
+     * Signal that releases the hold of this load on the resource, so that it may be evicted from the cache once nothing else holds it (`signal` by default; without either, the resource is held until `releaseResource(url)` is called)
+     */
+    release?: AbortSignal;
+}
+
+/**
+ * A resource that is being fetched
  * @internal
  */
-var resources: { [key: string]: Promise<multimediaResource_t> } = {};
+interface pendingResource_t {
+    /**
+     * @internal
+     */
+    task: scheduledTask_t<multimediaResource_t>;
+    /**
+     * Amount of loads that are still interested in the resource
+     * @internal
+     */
+    interested: number;
+}
 
 /**
- * Asynchronously load a resource
- * @async
+ * A resource that has been requested (kept once loaded, until it is evicted)
+ * @internal
+ */
+interface cachedResource_t {
+    /**
+     * @internal
+     */
+    promise: Promise<multimediaResource_t>;
+    /**
+     * The loaded resource (null whilst it is loading, or if it failed to load)
+     * @internal
+     */
+    resource: (multimediaResource_t | null);
+    /**
+     * Size of the loaded resource in bytes
+     * @internal
+     */
+    bytes: number;
+    /**
+     * Amount of loads that still hold the resource (it can only be evicted once none do)
+     * @internal
+     */
+    references: number;
+}
+
+/**
+ * Collection of requested resources (in order of least recent use)
+ * @internal
+ */
+var resources: Map<string, cachedResource_t> = new Map<string, cachedResource_t>();
+/**
+ * Resources that are yet to be fetched
+ * @internal
+ */
+var pending: { [key: string]: pendingResource_t } = {};
+/**
+ * Total size of the loaded resources in bytes
+ * @internal
+ */
+var cachedBytes: number = 0;
+/**
+ * The most bytes of loaded resources to keep once nothing holds them
+ * @internal
+ */
+var memoryBudget: number = 64 * 1024 * 1024;
+
+window.addEventListener("unload", () => {
+    resources.forEach((cached: cachedResource_t) => {
+        if (cached.resource !== null) {
+            URL.revokeObjectURL(cached.resource.blobUrl);
+        }
+    });
+});
+
+/**
+ * Evict the least recently used resources that nothing holds, until the loaded resources fit within the memory budget
+ * @internal
+ */
+function evictResources(): void {
+    for (const [url, cached] of resources) {
+        if (cachedBytes <= memoryBudget) {
+            return;
+        }
+        if (cached.resource === null || cached.references > 0) {
+            continue;
+        }
+        URL.revokeObjectURL(cached.resource.blobUrl);
+        cachedBytes -= cached.bytes;
+        resources.delete(url);
+    }
+}
+
+/**
+ * Release a hold on a resource
  * @param {string} url The location of the resource
- * @returns {Promise<multimediaResource_t>} The loaded resource
+ * @param {cachedResource_t} cached The resource that was held
+ * @internal
  */
-export function loadResource(url: string): Promise<multimediaResource_t> {
-    if (url in resources) {
-        return resources[url];
+function release(url: string, cached: cachedResource_t): void {
+    cached.references = Math.max(cached.references - 1, 0);
+    if (resources.get(url) === cached) {
+        evictResources();
     }
-    let blob: Promise<multimediaResource_t> = new Promise<multimediaResource_t>((resolve, reject) => {
-        const failure = (): void => {
-            reject(`Failed to load multimedia resource: ${url}`);
+}
+
+/**
+ * Request a resource without holding it (fetching it unless it is already cached)
+ * @param {string} url The location of the resource
+ * @param {resourcePriority_t} priority The priority of the resource
+ * @returns {cachedResource_t} The requested resource
+ * @internal
+ */
+function requestResource(url: string, priority: resourcePriority_t): cachedResource_t {
+    let cached: (cachedResource_t | undefined) = resources.get(url);
+    if (cached !== undefined) {
+        if (url in pending) {
+            pending[url].task.promote(priority);
         }
-        fetch(url).then(async (response) => {
+        // Now the most recently used
+        resources.delete(url);
+        resources.set(url, cached);
+        return cached;
+    }
+    let bytes: number = 0;
+    const task: scheduledTask_t<multimediaResource_t> = scheduler_t.schedule(priority, (signal: AbortSignal) => {
+        return fetch(url, { "signal": signal }).then(async (response) => {
             if (!response.ok) {
-                failure();
+                throw new Error(`Unexpected status: ${response.status}`);
             }
             const blob: Blob = await response.blob();
+            bytes = blob.size;
             const resource: multimediaResource_t = {
                 blobUrl: URL.createObjectURL(blob),
                 mimeType: blob.type
             }
-            window.addEventListener("unload", () => {
-                URL.revokeObjectURL(resource.blobUrl);
-            });
-            resolve(resource);
-        }).catch(() => failure());
+            return resource;
+        });
+    });
+    const requested: cachedResource_t = { "promise": task.promise, "resource": null, "bytes": 0, "references": 0 };
+    pending[url] = { "task": task, "interested": 0 };
+    requested.promise = task.promise.then((resource: multimediaResource_t) => {
+        delete pending[url];
+        requested.resource = resource;
+        requested.bytes = bytes;
+        cachedBytes += bytes;
+        evictResources();
+        return resource;
+    }, () => {
+        delete pending[url];
+        if (resources.get(url) === requested) {
+            resources.delete(url); // Aborted or failed (holding no bytes), so a later load fetches it again
+        }
+        throw `Failed to load multimedia resource: ${url}`;
+    });
+    resources.set(url, requested);
+    return requested;
+}
+
+/**
+ * Asynchronously load a resource, which is held (kept in the cache) until the load is released
+ * @async
+ * @param {string} url The location of the resource
+ * @param {resourceOptions_t} options The priority of the resource, a signal to abort loading it, and a signal to release it
+ * @returns {Promise<multimediaResource_t>} The loaded resource
+ */
+export function loadResource(url: string, options: resourceOptions_t = {}): Promise<multimediaResource_t> {
+    const cached: cachedResource_t = requestResource(url, options.priority ?? resourcePriority_t.visible);
+    const holder: (AbortSignal | undefined) = options.release ?? options.signal;
+    if (holder === undefined || !holder.aborted) {
+        cached.references++;
+        holder?.addEventListener("abort", () => release(url, cached), { "once": true });
+    }
+    const resource: Promise<multimediaResource_t> = cached.promise;
+    if (!(url in pending)) {
+        return resource;
+    }
+    const fetching: pendingResource_t = pending[url];
+    fetching.interested++;
+    const signal: (AbortSignal | undefined) = options.signal;
+    if (signal === undefined) {
+        return resource;
+    }
+    return new Promise<multimediaResource_t>((resolve, reject) => {
+        const abort = (): void => {
+            reject(`Stopped loading multimedia resource: ${url}`);
+            if (--fetching.interested == 0) {
+                fetching.task.cancel();
+            }
+        };
+        if (signal.aborted) {
+            abort();
+            return;
+        }
+        signal.addEventListener("abort", abort);
+        resource.then(resolve, reject).then(() => signal.removeEventListener("abort", abort));
     });
-    resources[url] = blob;
-    return blob;
+}
+
+/**
+ * Release a hold on a resource that was loaded without a signal to release it, so that it may be evicted from the cache once nothing else holds it
+ * @param {string} url The location of the resource
+ */
+export function releaseResource(url: string): void {
+    const cached: (cachedResource_t | undefined) = resources.get(url);
+    if (cached !== undefined) {
+        release(url, cached);
+    }
+}
+
+/**
+ * Set the most bytes of loaded resources to keep cached once nothing holds them (64 MiB by default); the least recently used are evicted first
+ * @param {number} bytes The most bytes to keep cached
+ */
+export function setResourceMemoryBudget(bytes: number): void {
+    memoryBudget = Math.max(bytes, 0);
+    evictResources();
+}
+
+/**
+ * Load a resource that is only expected to be used later (after everything else is fetched)
+ * @param {string} url The location of the resource
+ */
+export function prefetchResource(url: string): void {
+    requestResource(url, resourcePriority_t.prefetch).promise.catch(() => { }); // Reported once used (and not held, so it may be evicted)
+}
+
+/**
+ * Raise the priority of a resource that is yet to be fetched
+ * @param {string} url The location of the resource
+ * @param {resourcePriority_t} priority The new priority
+ * @internal
+ */
+export function promoteResource(url: string, priority: resourcePriority_t): void {
+    if (url in pending) {
+        pending[url].task.promote(priority);
+    }
+}
+
+/**
+ * Set the most resources that are fetched at once (6 by default)
+ * @param {number} limit The most resources that are fetched at once
+ */
+export function setResourceConcurrency(limit: number): void {
+    scheduler_t.setConcurrency(limit);
 }
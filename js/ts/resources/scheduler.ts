@@ -0,0 +1,218 @@
+/**
+ * Priority classes of resource fetches (fetched in order, then in the order they were scheduled)
+ */
+export enum resourcePriority_t {
+    /**
+     * Resources that the GUI cannot start without (the structure)
+     */
+    critical = 0,
+    /**
+     * Media of widgets that are visible
+     */
+    visible = 1,
+    /**
+     * Media of widgets that are not (yet) visible
+     */
+    offscreen = 2,
+    /**
+     * Resources that are only expected to be used later
+     */
+    prefetch = 3,
+}
+
+/**
+ * Handle of a scheduled fetch
+ * @internal
+ */
+export interface scheduledTask_t<T> {
+    /**
+     * Result of the task
+     * @internal
+     */
+    promise: Promise<T>;
+    /**
+     * Raise the priority of the task (if it has not started yet)
+     * @param {resourcePriority_t} priority The new priority
+     * @internal
+     */
+    promote(priority: resourcePriority_t): void;
+    /**
+     * Cancel the task, aborting it if it has started
+     * @internal
+     */
+    cancel(): void;
+}
+
+/**
+ * A task waiting for a free slot
+ * @internal
+ */
+interface queuedTask_t {
+    /**
+     * @internal
+     */
+    priority: resourcePriority_t;
+    /**
+     * Order the task was scheduled in
+     * @internal
+     */
+    sequence: number;
+    /**
+     * Start the task
+     * @internal
+     */
+    start: () => void;
+    /**
+     * Reject the task without starting it
+     * @internal
+     */
+    reject: (reason: any) => void;
+}
+
+/**
+ * Limits how many resources are fetched at once, and fetches them in order of priority
+ * @internal
+ */
+export abstract class scheduler_t {
+    /**
+     * The most tasks that run at once
+     * @internal
+     */
+    private static concurrency: number = 6;
+    /**
+     * Amount of tasks that are running
+     * @internal
+     */
+    private static active: number = 0;
+    /**
+     * Amount of tasks that have been scheduled
+     * @internal
+     */
+    private static scheduled: number = 0;
+    /**
+     * Tasks waiting for a free slot
+     * @internal
+     */
+    private static queue: queuedTask_t[] = [];
+    /**
+     * Observer of elements that promote their resources once visible
+     * @internal
+     */
+    private static observer: (IntersectionObserver | null) = null;
+    /**
+     * Callbacks of observed elements
+     * @internal
+     */
+    private static visible: Map<Element, () => void> = new Map<Element, () => void>();
+    /**
+     * Set the most resources that are fetched at once
+     * @param {number} limit The most resources that are fetched at once (at least 1)
+     * @internal
+     */
+    public static setConcurrency(limit: number): void {
+        if (!Number.isInteger(limit) || limit < 1) {
+            throw new Error(`"${limit}" is not a valid resource concurrency limit`);
+        }
+        this.concurrency = limit;
+        this.pump();
+    }
+    /**
+     * Schedule a task that holds a slot until it settles
+     * @param {resourcePriority_t} priority The priority of the task
+     * @param {function(AbortSignal): Promise<T>} run The task (given the signal that aborts it)
+     * @returns {scheduledTask_t<T>} Handle of the task
+     * @internal
+     */
+    public static schedule<T>(priority: resourcePriority_t, run: (signal: AbortSignal) => Promise<T>): scheduledTask_t<T> {
+        const controller: AbortController = new AbortController();
+        let queued!: queuedTask_t;
+        const promise: Promise<T> = new Promise<T>((resolve, reject) => {
+            queued = {
+                "priority": priority,
+                "sequence": this.scheduled++,
+                "start": () => {
+                    this.active++;
+                    let running: Promise<T>;
+                    try {
+                        running = run(controller.signal);
+                    } catch (error: any) {
+                        running = Promise.reject(error);
+                    }
+                    running.then(resolve, reject).then(() => {
+                        this.active--;
+                        this.pump();
+                    });
+                },
+                "reject": reject,
+            };
+        });
+        this.queue.push(queued);
+        this.pump();
+        return {
+            "promise": promise,
+            "promote": (promoted: resourcePriority_t): void => {
+                queued.priority = Math.min(queued.priority, promoted);
+            },
+            "cancel": (): void => {
+                const index: number = this.queue.indexOf(queued);
+                if (index >= 0) {
+                    this.queue.splice(index, 1);
+                    queued.reject(new DOMException("The fetch was cancelled", "AbortError"));
+                }
+                controller.abort();
+            },
+        };
+    }
+    /**
+     * Call a function once an element becomes visible
+     * @param {Element} element The element to observe
+     * @param {function(): void} callback The function to call
+     * @param {AbortSignal} signal Stops observing the element
+     * @internal
+     */
+    public static whenVisible(element: Element, callback: () => void, signal: AbortSignal): void {
+        if (typeof IntersectionObserver === "undefined" || signal.aborted) {
+            return;
+        }
+        if (this.observer === null) {
+            this.observer = new IntersectionObserver((entries: IntersectionObserverEntry[]) => {
+                entries.filter((entry: IntersectionObserverEntry) => entry.isIntersecting).forEach((entry: IntersectionObserverEntry) => {
+                    const visible: (() => void) | undefined = this.visible.get(entry.target);
+                    this.unobserve(entry.target);
+                    if (visible !== undefined) {
+                        visible();
+                    }
+                });
+            });
+        }
+        this.visible.set(element, callback);
+        this.observer.observe(element);
+        signal.addEventListener("abort", () => this.unobserve(element));
+    }
+    /**
+     * Stop observing an element
+     * @param {Element} element The element to stop observing
+     * @internal
+     */
+    private static unobserve(element: Element): void {
+        if (this.visible.delete(element)) {
+            this.observer!.unobserve(element);
+        }
+    }
+    /**
+     * Start the most urgent tasks whilst slots are free
+     * @internal
+     */
+    private static pump(): void {
+        while (this.active < this.concurrency && this.queue.length > 0) {
+            let next: number = 0;
+            this.queue.forEach((queued: queuedTask_t, index: number) => {
+                const best: queuedTask_t = this.queue[next];
+                if (queued.priority < best.priority || (queued.priority == best.priority && queued.sequence < best.sequence)) {
+                    next = index;
+                }
+            });
+            this.queue.splice(next, 1)[0].start();
+        }
+    }
+}
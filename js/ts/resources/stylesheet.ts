@@ -1,24 +1,24 @@
-import { loadResource, multimediaResource_t } from "./resource";
-
 /**
  * Asynchronously load a stylesheet
+ *
+ * The stylesheet is linked by its own location (rather than through a blob), so that its relative `url()` references resolve and any copy that the HTML file preloaded is reused
  * @async
  * @param {string} url The location of the stylesheet
  * @returns {Promise<void>} Success of the loading of the stylesheet
  */
 export function loadStylesheet(url: string): Promise<void> {
     return new Promise<void>((resolve, reject) => {
-        const failure = (): void => {
-            reject(`Failed to load stylesheet: ${url}`);
+        const stylesheet: HTMLLinkElement = document.createElement("link");
+        stylesheet.rel = "stylesheet";
+        stylesheet.href = url;
+        // Already applied by the HTML file (such as for pre-rendered widgets)
+        const linked: HTMLLinkElement[] = Array.from(document.querySelectorAll<HTMLLinkElement>("link[rel=\"stylesheet\"]"));
+        if (linked.some((link: HTMLLinkElement) => link.href === stylesheet.href && link.sheet !== null)) {
+            resolve();
+            return;
         }
-        loadResource(url).then((resource: multimediaResource_t) => {
-            const stylesheet: HTMLLinkElement = document.createElement("link");
-            stylesheet.rel = "stylesheet";
-            stylesheet.type = resource.mimeType;
-            stylesheet.href = resource.blobUrl;
-            stylesheet.onload = () => resolve();
-            stylesheet.onerror = () => failure();
-            document.head.appendChild(stylesheet);
-        }).catch(() => failure());
+        stylesheet.onload = () => resolve();
+        stylesheet.onerror = () => reject(`Failed to load stylesheet: ${url}`);
+        document.head.appendChild(stylesheet);
     });
 }
@@ -0,0 +1,127 @@
+/**
+ * Interface for the precache manifest
+ * @internal
+ */
+interface precacheManifest_t {
+    /**
+     * The version of the manifest (changes whenever any published file changes)
+     * @internal
+     */
+    version: string;
+    /**
+     * Paths of published files (relative to the root) and the hash of their contents
+     * @internal
+     */
+    files: { [path: string]: string };
+}
+
+/**
+ * Events of a service worker that can extend their lifetime
+ * @internal
+ */
+interface extendableEvent_t extends Event {
+    waitUntil(promise: Promise<any>): void;
+}
+
+/**
+ * Fetch events of a service worker
+ * @internal
+ */
+interface fetchEvent_t extends extendableEvent_t {
+    request: Request;
+    respondWith(response: Promise<Response>): void;
+}
+
+/**
+ * The precache manifest - expected to be declared ahead of the service worker by the generator
+ * @internal
+ */
+declare var manifest: precacheManifest_t;
+
+/**
+ * The global scope of the service worker
+ * @internal
+ */
+const serviceWorker: any = self;
+
+/**
+ * Name of the cache that holds precached files
+ * @internal
+ */
+const precacheName: string = "sss-guis-precache";
+
+/**
+ * Get the URL of a published file
+ * @param {string} path The path of the published file
+ * @returns {string} The URL of the file
+ * @internal
+ */
+function precacheUrl(path: string): string {
+    return new URL(path.split("/").map(part => encodeURIComponent(part)).join("/"), serviceWorker.registration.scope).href;
+}
+
+/**
+ * Get the cache key of a published file (changes with its contents, so unchanged files are never refetched)
+ * @param {string} url The URL of the published file
+ * @param {string} hash The hash of the contents of the file
+ * @returns {string} The cache key of the file
+ * @internal
+ */
+function precacheKey(url: string, hash: string): string {
+    const key: URL = new URL(url);
+    key.searchParams.set("sss-guis-hash", hash);
+    return key.href;
+}
+
+/**
+ * Cache keys of published files (keyed by URL)
+ * @internal
+ */
+const precacheKeys: { [url: string]: string } = {};
+Object.entries(manifest.files).forEach(([path, hash]) => {
+    const url: string = precacheUrl(path);
+    precacheKeys[url] = precacheKey(url, hash);
+});
+
+serviceWorker.addEventListener("install", (event: extendableEvent_t) => {
+    // Only fetch files whose contents are not already cached
+    event.waitUntil(caches.open(precacheName).then(async (cache: Cache) => {
+        await Promise.all(Object.entries(precacheKeys).map(async ([url, key]) => {
+            if (await cache.match(key) !== undefined) {
+                return;
+            }
+            const response: Response = await fetch(url, { cache: "reload" });
+            if (!response.ok) {
+                throw new Error(`Failed to precache: ${url}`);
+            }
+            await cache.put(key, response);
+        }));
+        await serviceWorker.skipWaiting();
+    }));
+});
+
+serviceWorker.addEventListener("activate", (event: extendableEvent_t) => {
+    // Remove files that are no longer published (or have changed)
+    const keys: Set<string> = new Set<string>(Object.values(precacheKeys));
+    event.waitUntil(caches.open(precacheName).then(async (cache: Cache) => {
+        await Promise.all((await cache.keys()).filter((request: Request) => !keys.has(request.url)).map((request: Request) => cache.delete(request)));
+        await serviceWorker.clients.claim();
+    }));
+});
+
+serviceWorker.addEventListener("fetch", (event: fetchEvent_t) => {
+    if (event.request.method !== "GET") {
+        return;
+    }
+    const url: URL = new URL(event.request.url);
+    url.search = "";
+    url.hash = "";
+    const key: (string | undefined) = precacheKeys[url.href];
+    if (key === undefined) {
+        return;
+    }
+    event.respondWith(caches.open(precacheName).then(async (cache: Cache) => {
+        const response: (Response | undefined) = await cache.match(key);
+        return ((response !== undefined) ? response : fetch(event.request));
+    }));
+});
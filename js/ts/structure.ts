@@ -1,61 +1,75 @@
+import { resourcePriority_t, scheduler_t } from "./resources/scheduler";
+import { decodedStructure_t, decodedWidget_t, decodeStructureInWorker } from "./structureDecoder";
+import { span, spanAsync } from "./telemetry";
+import { deferred_t } from "./widgets/deferred";
 import { widget_t } from "./widgets/widget";
 
 /**
- * Tuple structure of widget contents
- * @first Type of widget
- * @second Configuration of widget
- * @internal
- */
-type structure_widget_schema_t = [number, any];
-
-/**
- * Interface for the structure of GUI
+ * Tuple positional references
  * @internal
  */
-interface structure_schema_t {
-    /**
-     * Array or object consisting of widgets
-     * @variation Array Is expected by default
-     * @variation Object Is expected for debug variants
-     * @internal
-     */
-    widgets: structure_widget_schema_t[] | { [key: string]: structure_widget_schema_t };
+enum widgetData_t {
     /**
-     * Types of widgets that are used by the structure
+     * Reference for the type of the widget
      * @internal
      */
-    types: string[];
+    widgetDataType = 0,
     /**
-     * Reference to the main object
-     * @variation number Is expected by default
-     * @variation string Is expected for debug variants
+     * Reference for the (expanded JSON) configuration of the widget
      * @internal
      */
-    main: (number | string);
+    widgetDataConfiguration = 1,
 }
 
 /**
- * Tuple positional references
+ * @brief The type of a widget reference identifier
+ */
+export type widgetIdentifier_t = (string | number);
+
+/**
+ * Whether two configurations are equal (regardless of the order of their keys)
+ * @param {any} a A configuration
+ * @param {any} b Another configuration
+ * @returns {boolean} Whether the configurations are equal
  * @internal
  */
-enum widgetData_t {
+function sameConfiguration(a: any, b: any): boolean {
+    if (a === null || b === null || typeof a !== "object" || typeof b !== "object") {
+        return (a === b);
+    }
+    if (Array.isArray(a) !== Array.isArray(b)) {
+        return false;
+    }
+    const keys: string[] = Object.keys(a);
+    return (keys.length == Object.keys(b).length && keys.every((key: string) => Object.prototype.hasOwnProperty.call(b, key) && sameConfiguration(a[key], b[key])));
+}
+
+/**
+ * A created widget (tracked so that hot updates can replace it in place)
+ * @internal
+ */
+interface instance_t {
     /**
-     * Reference for the type of the widget
+     * Reference to the widget within the structure
      * @internal
      */
-    widgetDataType = 0,
+    identifier: widgetIdentifier_t;
     /**
-     * Reference for the configuration of the widget
      * @internal
      */
-    widgetDataConfiguration = 1,
+    widget: widget_t;
+    /**
+     * The element that the widget last rendered (null until it has rendered)
+     * @internal
+     */
+    element: (HTMLElement | null);
+    /**
+     * The widget that created this widget whilst being configured (null for the main widget, or widgets created outside of a configuration)
+     * @internal
+     */
+    parent: (instance_t | null);
 }
 
-/**
- * @brief The type of a widget reference identifier
- */
-export type widgetIdentifier_t = (string | number);
-
 /**
  * Manage structural widgets
  * @internal
@@ -75,7 +89,32 @@ export abstract class structure_t {
      * Structure of GUI
      * @internal
      */
-    private static structure: structure_schema_t;
+    private static structure: decodedStructure_t;
+    /**
+     * Promise of all modules having loaded (whilst pending, widgets of undeclared types are deferred)
+     * @internal
+     */
+    private static modules: (Promise<void> | null) = null;
+    /**
+     * How many widgets are currently being created within each other
+     * @internal
+     */
+    private static nesting: number = 0;
+    /**
+     * Widgets that have been created and not discarded
+     * @internal
+     */
+    private static instances: Map<widget_t, instance_t> = new Map<widget_t, instance_t>();
+    /**
+     * The widget currently being configured (the parent of any widget created meanwhile)
+     * @internal
+     */
+    private static creating: (instance_t | null) = null;
+    /**
+     * The main widget
+     * @internal
+     */
+    private static root: (instance_t | null) = null;
     /**
      * Declare a widget type that applies to a factory that can be created from a structure
      * @param {string} type The widget type to construct
@@ -88,14 +127,26 @@ export abstract class structure_t {
         }
         this.widgetDeclarations[type] = widget;
     }
+    /**
+     * Defer the creation of widgets of undeclared types until modules have loaded, instead of failing
+     * @param {Promise<void>} modules Promise of all modules having loaded
+     * @internal
+     */
+    public static deferUntil(modules: Promise<void>): void {
+        this.modules = modules;
+        modules.then(() => {
+            this.modules = null;
+        }).catch(() => { });
+    }
     /**
      * Asynchronously generate a structure
      * @async
      * @param {string} structure Path for structure location
+     * @param {Element | null} prerendered The pre-rendered element of the main widget to hydrate
      * @returns {Promise<widget_t>}
      * @internal
      */
-    public static async generate(structure: string): Promise<widget_t> {
+    public static async generate(structure: string, prerendered: (Element | null) = null): Promise<widget_t> {
         if (!this.gotStructure) {
             if (structure == null) {
                 throw new Error("No structure path was provided");
@@ -103,32 +154,161 @@ export abstract class structure_t {
             await this.get(structure).then(response => {
                 this.structure = response;
                 this.gotStructure = true;
-            }).catch((_reason: any) => {
-                throw new Error("Failed to get structure of GUI");
+            }).catch((reason: any) => {
+                throw new Error(`Failed to get structure of GUI: ${(reason instanceof Error) ? reason.message : reason}`);
             });
         }
-        return this.widget(this.structure.main);
+        const main: widget_t = this.widget(this.structure.main, prerendered);
+        this.root = this.instances.get(main) ?? null;
+        return main;
+    }
+    /**
+     * Get the structure that is currently shown
+     * @returns {decodedStructure_t} The decoded structure
+     * @internal
+     */
+    public static current(): decodedStructure_t {
+        return this.structure;
+    }
+    /**
+     * Update the structure in place, replacing only the widgets whose configuration changed (the nearest widget that can be replaced is replaced instead when a changed widget is not shown, such as within an inactive tab)
+     * @async
+     * @param {decodedStructure_t} structure The new structure
+     * @returns {Promise<void>}
+     * @internal
+     */
+    public static async update(structure: decodedStructure_t): Promise<void> {
+        const previous: decodedStructure_t = this.structure;
+        const lookup = (decoded: decodedStructure_t, identifier: widgetIdentifier_t): (decodedWidget_t | undefined) => {
+            return (Object.prototype.hasOwnProperty.call(decoded.widgets, identifier) ? (decoded.widgets as any)[identifier] : undefined);
+        };
+        const changed = (identifier: widgetIdentifier_t): boolean => {
+            const before: (decodedWidget_t | undefined) = lookup(previous, identifier);
+            const after: (decodedWidget_t | undefined) = lookup(structure, identifier);
+            if (before === undefined || after === undefined || previous.types[before[0]] !== structure.types[after[0]]) {
+                return true;
+            }
+            return (before[1] !== after[1] && !sameConfiguration(JSON.parse(before[1]), JSON.parse(after[1])));
+        };
+        this.structure = structure;
+        const root: (instance_t | null) = this.root;
+        if (root === null) {
+            throw new Error("The main widget cannot be updated in place");
+        }
+        // Escalate from each changed widget to the nearest widget that is in place (its parent refers to it, and its element can be swapped)
+        const targets: Set<instance_t> = new Set<instance_t>();
+        if (previous.main !== structure.main || changed(structure.main)) {
+            targets.add(root);
+        }
+        this.instances.forEach((instance: instance_t) => {
+            if (!changed(instance.identifier)) {
+                return;
+            }
+            let target: instance_t = instance;
+            while (target !== root && (lookup(structure, target.identifier) === undefined || target.element === null || target.element.parentNode === null)) {
+                target = target.parent ?? root;
+            }
+            targets.add(target);
+        });
+        const replaced: instance_t[] = Array.from(targets).filter((target: instance_t) => {
+            for (let ancestor: (instance_t | null) = target.parent; ancestor !== null; ancestor = ancestor.parent) {
+                if (targets.has(ancestor)) {
+                    return false; // Replaced along with its ancestor
+                }
+            }
+            return true;
+        });
+        await Promise.all(replaced.map(async (target: instance_t) => {
+            if (target.element === null) {
+                throw new Error(`Unable to replace widget "${target.identifier}" as it has not rendered`);
+            }
+            const previousElement: HTMLElement = target.element;
+            const replacement: widget_t = this.within(target.parent, () => this.widget((target === root) ? structure.main : target.identifier));
+            const element: HTMLElement = await replacement.render();
+            previousElement.replaceWith(element);
+            if (target.parent !== null) {
+                target.parent.widget.childReplaced(previousElement, element);
+            }
+            // The parent still refers to the replaced widget, so it forwards to its replacement
+            target.widget.discard();
+            target.widget.render = (): Promise<HTMLElement> => replacement.render();
+            target.widget.discard = (): void => replacement.discard();
+            target.widget.detach = (): void => replacement.detach();
+            target.widget.attach = (): void => replacement.attach();
+            if (target === root) {
+                this.root = this.instances.get(replacement) ?? { "identifier": structure.main, "widget": replacement, "element": element, "parent": null };
+            }
+        }));
     }
     /**
      * Get a widget
      * @param {widgetIdentifier_t} identifier Reference to a widget
+     * @param {Element | null} prerendered The pre-rendered element of the widget to hydrate (if any)
      * @returns {widget_t} Widget
      * @internal
      */
-    public static widget(identifier: widgetIdentifier_t): widget_t {
+    public static widget(identifier: widgetIdentifier_t, prerendered: (Element | null) = null): widget_t {
         if (!this.widgetExists(identifier)) {
             throw new Error(`No widget exists with the identifier "${identifier}"`);
         }
         // @ts-ignore - to allow either a number or a string to be an index
         let type: string = this.structure.types[this.structure.widgets[identifier][widgetData_t.widgetDataType]];
         if (!(type in this.widgetDeclarations)) {
+            if (this.modules !== null) {
+                // The type may be declared by a module that is still loading
+                const parent: (instance_t | null) = this.creating;
+                return new deferred_t(() => this.within(parent, () => this.widget(identifier, prerendered)), this.modules.then(() => {
+                    this.modules = null;
+                }));
+            }
             throw new Error(`Unable to create widget of "${type}" which is an unknown widget type`);
         }
         let widget: widget_t = this.widgetDeclarations[type]();
-        // @ts-ignore - to allow either a number or a string to be an index
-        widget.configuration(this.structure.widgets[identifier][widgetData_t.widgetDataConfiguration] || {});
+        widget.hydrate(prerendered);
+        // Children are created whilst configuring, so nesting beyond the depth of the structure can only be a recursive reference
+        if (this.nesting > this.structure.depth) {
+            throw new Error(`Widget "${identifier}" is nested deeper than the structure allows (it may be referenced recursively)`);
+        }
+        const instance: instance_t = { "identifier": identifier, "widget": widget, "element": null, "parent": this.creating };
+        this.nesting++;
+        try {
+            this.within(instance, () => span(`configuration:${type}:${identifier}`, () => {
+                // @ts-ignore - to allow either a number or a string to be an index
+                widget.configuration(JSON.parse(this.structure.widgets[identifier][widgetData_t.widgetDataConfiguration]));
+            }));
+        } finally {
+            this.nesting--;
+        }
+        // Time every render of the widget (which includes the render of its children)
+        const render: () => Promise<HTMLElement> = widget.render.bind(widget);
+        widget.render = (): Promise<HTMLElement> => spanAsync(`render:${type}:${identifier}`, render).then((element: HTMLElement) => {
+            instance.element = element;
+            return element;
+        });
+        const discard: () => void = widget.discard.bind(widget);
+        widget.discard = (): void => {
+            this.instances.delete(widget);
+            discard();
+        };
+        this.instances.set(widget, instance);
         return widget;
     }
+    /**
+     * Create widgets as if within the configuration of a widget (so that they are tracked as its children)
+     * @param {instance_t | null} parent The widget to create within
+     * @param {function(): T} create Creates the widgets
+     * @returns {T} The result of `create`
+     * @internal
+     */
+    private static within<T>(parent: (instance_t | null), create: () => T): T {
+        const creating: (instance_t | null) = this.creating;
+        this.creating = parent;
+        try {
+            return create();
+        } finally {
+            this.creating = creating;
+        }
+    }
     /**
      * Check whether a widget exists
      * @param {widgetIdentifier_t} identifier Reference to a widget
@@ -140,7 +320,7 @@ export abstract class structure_t {
             if (typeof identifier != "number") {
                 throw new Error(`Unable to check if the widget "${identifier}" exists as a numeric identifier was expected`);
             }
-            return (identifier >= 0 && identifier < this.structure.widgets.length);
+            return (identifier >= 0 && identifier < this.structure.widgets.length && this.structure.widgets[identifier] !== undefined);
         } else if (typeof identifier != "string") {
             throw new Error(`Unable to check if the widget "${identifier}" exists as a string identifier was expected`);
         } else {
@@ -148,16 +328,20 @@ export abstract class structure_t {
         }
     }
     /**
-     * Get the structure of the GUI
+     * Get the structure of the GUI (decoded and validated off the main thread)
      * @param {structure} Path for structure location
-     * @returns {Promise<structure_schema_t>}
+     * @returns {Promise<decodedStructure_t>}
      * @internal
      */
-    private static async get(structure: string): Promise<structure_schema_t> {
-        return fetch(structure).then(response => response.json()).then(response => {
-            return response as structure_schema_t;
-        }).catch(_error => {
-            throw new Error("Failed to parse a valid JSON structure");
-        });
+    private static async get(structure: string): Promise<decodedStructure_t> {
+        const buffer: ArrayBuffer = await spanAsync("structure:fetch", () => scheduler_t.schedule(resourcePriority_t.critical, (signal: AbortSignal) => {
+            return fetch(structure, { "signal": signal }).then((response: Response) => {
+                if (!response.ok) {
+                    throw new Error(`Failed to fetch the structure (status ${response.status})`);
+                }
+                return response.arrayBuffer();
+            });
+        }).promise);
+        return spanAsync("structure:parse", () => decodeStructureInWorker(buffer));
     }
 }
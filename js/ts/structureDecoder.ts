@@ -0,0 +1,297 @@
+/**
+ * A decoded widget
+ * @first Index of the type of widget
+ * @second Expanded configuration of widget (as JSON, only parsed once the widget is created)
+ * @internal
+ */
+export type decodedWidget_t = [number, string];
+
+/**
+ * Interface for a decoded (and validated) structure of GUI
+ * @internal
+ */
+export interface decodedStructure_t {
+    /**
+     * Array or object consisting of widgets
+     * @variation Array Is expected by default
+     * @variation Object Is expected for debug variants
+     * @internal
+     */
+    widgets: decodedWidget_t[] | { [key: string]: decodedWidget_t };
+    /**
+     * Types of widgets that are used by the structure
+     * @internal
+     */
+    types: string[];
+    /**
+     * Reference to the main object
+     * @internal
+     */
+    main: (number | string);
+    /**
+     * The length of the longest chain of references from the main object
+     * @internal
+     */
+    depth: number;
+}
+
+/**
+ * Decode a structure, expanding minified configurations and validating the configurations of core widgets
+ *
+ * This is serialised into a worker, so it must not reference anything declared outside of itself
+ * @param {string} text The structure as generated (JSON, with `widgets`, `types`, `main`, and optionally `keys`, `shared`, `order`, and `depth`)
+ * @returns {decodedStructure_t} The decoded structure
+ * @internal
+ */
+export function decodeStructure(text: string): decodedStructure_t {
+    let structure: any;
+    try {
+        structure = JSON.parse(text);
+    } catch {
+        throw new Error("Failed to parse a valid JSON structure");
+    }
+    if (structure === null || typeof structure !== "object" || !Array.isArray(structure.types) ||
+        structure.widgets === null || typeof structure.widgets !== "object") {
+        throw new Error("Failed to parse a valid JSON structure");
+    }
+    const keys: (string[] | undefined) = structure.keys;
+    const shared: (any[] | undefined) = structure.shared;
+    const numeric: boolean = Array.isArray(structure.widgets);
+    // Only widgets reachable from the main object are decoded (in one pass, parents before children) when the order is given
+    const order: (any[] | null) = (Array.isArray(structure.order) ? structure.order : null);
+    const reachable: (Set<any> | null) = (order === null ? null : new Set<any>(order));
+    const has = (value: any, key: string): boolean => (value !== null && typeof value === "object" && value[key] !== undefined);
+    const expand = (configuration: any): any => {
+        if (keys === undefined || configuration === null || typeof configuration !== "object") {
+            return configuration;
+        }
+        if (Array.isArray(configuration)) {
+            return configuration.map((item: any) => expand(item));
+        }
+        if ("" in configuration) {
+            const index: number = configuration[""];
+            if (shared === undefined || !(index >= 0 && index < shared.length)) {
+                throw new Error(`No shared configuration exists with the index "${index}"`);
+            }
+            return expand(shared[index]);
+        }
+        const expanded: { [key: string]: any } = {};
+        Object.keys(configuration).forEach((key: string) => {
+            const name: (string | undefined) = keys[Number(key)];
+            if (name === undefined) {
+                throw new Error(`No configuration key exists with the index "${key}"`);
+            }
+            expanded[name] = expand(configuration[key]);
+        });
+        return expanded;
+    };
+    const exists = (identifier: any): boolean => {
+        if (reachable !== null && !reachable.has(identifier)) {
+            return false;
+        }
+        if (numeric) {
+            return (typeof identifier === "number" && identifier >= 0 && identifier < structure.widgets.length);
+        }
+        return (typeof identifier === "string" && Object.prototype.hasOwnProperty.call(structure.widgets, identifier));
+    };
+    const reference = (identifier: any, widget: string): void => {
+        if (!exists(identifier)) {
+            throw new Error(`Widget "${widget}" references "${identifier}", but no widget exists with that identifier`);
+        }
+    };
+    const sizes = (values: any, name: string, widget: string): number => {
+        if (!Array.isArray(values)) {
+            throw new Error(`A layout needs a numeric set of \`${name}\` (widget "${widget}")`);
+        }
+        values.forEach((size: any) => {
+            if (typeof size !== "number" || size < 0) {
+                throw new Error(`A layout requires positive numerical ${name} sizes - not "${size}" (widget "${widget}")`);
+            }
+        });
+        return values.length;
+    };
+    // Only core widgets are validated, as their types can never be declared by modules
+    const validate = (type: string, configuration: any, widget: string): void => {
+        switch (type) {
+            case "layout": {
+                const maxItems: number = sizes(configuration.columns, "columns", widget) * sizes(configuration.rows, "rows", widget);
+                if (configuration.items === undefined) {
+                    break;
+                }
+                if (!Array.isArray(configuration.items)) {
+                    throw new Error(`A layout's \`items\` must be a list (widget "${widget}")`);
+                }
+                if (configuration.items.length > maxItems) {
+                    throw new Error(`A layout has ${configuration.items.length} items but only ${maxItems} cells (widget "${widget}"), consider increasing \`columns\` or \`rows\``);
+                }
+                configuration.items.forEach((item: any) => {
+                    if (!has(item, "object")) {
+                        throw new Error(`Layout item has no reference to an object (widget "${widget}")`);
+                    }
+                    if (item.object !== null) {
+                        reference(item.object, widget);
+                    }
+                });
+                break;
+            }
+            case "container":
+                if (!(typeof configuration.title === "string" || typeof configuration.title === "number")) {
+                    throw new Error(`A container needs a title to be either a string or a number (widget "${widget}")`);
+                }
+                if (!has(configuration, "object")) {
+                    throw new Error(`A container has no reference to an object (widget "${widget}")`);
+                }
+                reference(configuration.object, widget);
+                break;
+            case "tabs": {
+                if (!Array.isArray(configuration.items) || configuration.items.length == 0) {
+                    throw new Error(`A tabs widget is missing \`items\` (widget "${widget}")`);
+                }
+                const names: { [key: string]: boolean } = Object.create(null);
+                configuration.items.forEach((item: any) => {
+                    if (!has(item, "name") || !(typeof item.name === "string" || typeof item.name === "number")) {
+                        throw new Error(`A tab name needs to be either a string or a number (widget "${widget}")`);
+                    }
+                    const name: string = item.name.toString();
+                    if (names[name]) {
+                        throw new Error(`Another tab exists with the name of "${name}" within a tab widget (widget "${widget}")`);
+                    }
+                    names[name] = true;
+                    if (!has(item, "object")) {
+                        throw new Error(`Tab "${name}" has no reference to an object (widget "${widget}")`);
+                    }
+                    reference(item.object, widget);
+                });
+                if (configuration.position !== undefined && ["top", "right", "bottom", "left"].indexOf(configuration.position) < 0) {
+                    throw new Error(`"${configuration.position}" is not a valid position for a collection of tabs (widget "${widget}")`);
+                }
+                break;
+            }
+            case "banner":
+            case "text":
+                if (!has(configuration, "text")) {
+                    throw new Error(`A ${type} widget requires \`text\` to be shown (widget "${widget}")`);
+                }
+                break;
+            case "image":
+            case "video":
+            case "audio":
+                if (!has(configuration, "source")) {
+                    throw new Error(`Missing \`source\` for a ${type} widget (widget "${widget}")`);
+                }
+                break;
+        }
+    };
+    const widgets: any = (numeric ? [] : {});
+    const identifiers: any[] = (order !== null ? order : Object.keys(structure.widgets).map((identifier: string) => (numeric ? Number(identifier) : identifier)));
+    identifiers.forEach((identifier: any) => {
+        if (!exists(identifier)) {
+            throw new Error(`No widget exists with the identifier "${identifier}"`);
+        }
+        const widget: any = structure.widgets[identifier];
+        if (!Array.isArray(widget) || typeof widget[0] !== "number" || typeof structure.types[widget[0]] !== "string") {
+            throw new Error(`Widget "${identifier}" is not a valid widget`);
+        }
+        const configuration: any = expand(widget[1] || {});
+        validate(structure.types[widget[0]], configuration, identifier);
+        widgets[identifier] = [widget[0], JSON.stringify(configuration)];
+    });
+    if (!exists(structure.main)) {
+        throw new Error(`No main widget exists with the identifier "${structure.main}"`);
+    }
+    const depth: number = (typeof structure.depth === "number" ? structure.depth : Number.POSITIVE_INFINITY);
+    return { "widgets": widgets, "types": structure.types, "main": structure.main, "depth": depth };
+}
+
+/**
+ * Apply a structure delta (as generated for hot updates) to the structure that is currently shown
+ * @param {decodedStructure_t} current The decoded structure that is currently shown
+ * @param {string} version The version of the structure that is currently shown
+ * @param {string} text The delta (JSON, with `base`, `types`, `main`, `order`, `depth`, the changed `widgets`, and the `removed` identifiers)
+ * @returns {string} The updated structure (to be decoded like a fetched structure)
+ * @internal
+ */
+export function mergeStructureDelta(current: decodedStructure_t, version: string, text: string): string {
+    const delta: any = JSON.parse(text);
+    if (delta === null || typeof delta !== "object" || delta.base !== version || !Array.isArray(delta.types) ||
+        delta.widgets === null || typeof delta.widgets !== "object" || !Array.isArray(delta.removed)) {
+        throw new Error("The structure delta does not apply to the current structure");
+    }
+    const numeric: boolean = Array.isArray(current.widgets);
+    const types: { [type: string]: number } = Object.create(null);
+    delta.types.forEach((type: string, index: number) => {
+        types[type] = index;
+    });
+    const removed: Set<string> = new Set<string>(delta.removed.map((identifier: any) => String(identifier)));
+    // Unchanged widgets keep their (already expanded) configurations, so only their type is renumbered
+    const widgets: { [identifier: string]: string } = Object.create(null);
+    Object.keys(current.widgets).filter((identifier: string) => !removed.has(identifier)).forEach((identifier: string) => {
+        const widget: decodedWidget_t = (current.widgets as any)[identifier];
+        const type: (number | undefined) = types[current.types[widget[0]]];
+        if (type === undefined) {
+            throw new Error(`The structure delta has no type for widget "${identifier}"`);
+        }
+        widgets[identifier] = `[${type},${widget[1]}]`;
+    });
+    Object.keys(delta.widgets).forEach((identifier: string) => {
+        widgets[identifier] = JSON.stringify(delta.widgets[identifier]);
+    });
+    let encoded: string;
+    if (numeric) {
+        const length: number = Object.keys(widgets).reduce((length: number, identifier: string) => Math.max(length, Number(identifier) + 1), 0);
+        const entries: string[] = [];
+        for (let identifier: number = 0; identifier < length; identifier++) {
+            entries.push(widgets[identifier] ?? "null");
+        }
+        encoded = `[${entries.join(",")}]`;
+    } else {
+        encoded = `{${Object.keys(widgets).map((identifier: string) => `${JSON.stringify(identifier)}:${widgets[identifier]}`).join(",")}}`;
+    }
+    return `{"widgets":${encoded},"types":${JSON.stringify(delta.types)},"main":${JSON.stringify(delta.main)},"order":${JSON.stringify(delta.order)},"depth":${JSON.stringify(delta.depth)}}`;
+}
+
+/**
+ * Decode a structure in a worker, so that the main thread stays responsive (falling back to the main thread if workers are unavailable)
+ * @param {ArrayBuffer} buffer The structure as fetched
+ * @returns {Promise<decodedStructure_t>} The decoded structure
+ * @internal
+ */
+export function decodeStructureInWorker(buffer: ArrayBuffer): Promise<decodedStructure_t> {
+    const decodeHere = (): decodedStructure_t => decodeStructure(new TextDecoder().decode(buffer));
+    let worker: Worker;
+    let source: string;
+    try {
+        source = URL.createObjectURL(new Blob([
+            `const decodeStructure=${decodeStructure.toString()};`,
+            `self.onmessage=(event)=>{try{self.postMessage({"structure":decodeStructure(new TextDecoder().decode(event.data))});}catch(error){self.postMessage({"error":String((error&&error.message)||error)});}};`
+        ], { "type": "text/javascript" }));
+        worker = new Worker(source);
+    } catch {
+        return Promise.resolve().then(decodeHere);
+    }
+    return new Promise<decodedStructure_t>((resolve, reject) => {
+        const finish = (): void => {
+            worker.terminate();
+            URL.revokeObjectURL(source);
+        };
+        worker.onmessage = (event: MessageEvent) => {
+            finish();
+            if (event.data.error !== undefined) {
+                reject(new Error(event.data.error));
+            } else {
+                resolve(event.data.structure as decodedStructure_t);
+            }
+        };
+        worker.onerror = (event: ErrorEvent) => {
+            // The worker could not start (such as when blocked by a content security policy)
+            event.preventDefault();
+            finish();
+            try {
+                resolve(decodeHere());
+            } catch (error: any) {
+                reject(error);
+            }
+        };
+        worker.postMessage(buffer); // Copied rather than transferred, so that the fallback can still read it
+    });
+}
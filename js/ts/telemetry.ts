@@ -0,0 +1,114 @@
+/**
+ * Prefix of the names of performance entries that are recorded by the GUI
+ * @internal
+ */
+const entryPrefix: string = "sss-guis:";
+
+/**
+ * Interface for a recorded timing
+ */
+export interface timing_t {
+    /**
+     * Name of the span (such as `render:text:3`)
+     */
+    name: string;
+    /**
+     * Time that the span started (in milliseconds since navigation started)
+     */
+    start: number;
+    /**
+     * Duration of the span (in milliseconds)
+     */
+    duration: number;
+}
+
+/**
+ * Record a span that started at a time and ends now
+ * @param {string} name Name of the span
+ * @param {number} start Time that the span started
+ * @internal
+ */
+export function measure(name: string, start: number): void {
+    try {
+        performance.measure(entryPrefix + name, { "start": start, "end": performance.now() });
+    } catch {
+        // Timings are best effort, so an unsupported browser still renders the GUI
+    }
+}
+
+/**
+ * Record a point in time
+ * @param {string} name Name of the point
+ * @internal
+ */
+export function mark(name: string): void {
+    try {
+        performance.mark(entryPrefix + name);
+    } catch {
+        // Timings are best effort, so an unsupported browser still renders the GUI
+    }
+}
+
+/**
+ * Time a synchronous function
+ * @param {string} name Name of the span
+ * @param {function(): T} run The function to time
+ * @returns {T} Result of the function
+ * @internal
+ */
+export function span<T>(name: string, run: () => T): T {
+    const start: number = performance.now();
+    try {
+        return run();
+    } finally {
+        measure(name, start);
+    }
+}
+
+/**
+ * Time an asynchronous function until its promise settles
+ * @param {string} name Name of the span
+ * @param {function(): Promise<T>} run The function to time
+ * @returns {Promise<T>} Promise of the function, settling once the span is recorded
+ * @internal
+ */
+export function spanAsync<T>(name: string, run: () => Promise<T>): Promise<T> {
+    const start: number = performance.now();
+    return run().then((value: T) => {
+        measure(name, start);
+        return value;
+    }, (error: any) => {
+        measure(name, start);
+        throw error;
+    });
+}
+
+/**
+ * Get the timings recorded by the GUI (splash display, module loads, structure fetch and parse, widget configuration and render, and the final DOM commit)
+ * @returns {timing_t[]} Recorded timings in the order they started
+ */
+export function timings(): timing_t[] {
+    return performance.getEntriesByType("measure").filter((entry: PerformanceEntry) => entry.name.startsWith(entryPrefix)).map((entry: PerformanceEntry) => {
+        return { "name": entry.name.substring(entryPrefix.length), "start": entry.startTime, "duration": entry.duration };
+    }).sort((a: timing_t, b: timing_t) => a.start - b.start);
+}
+
+/**
+ * Send the recorded timings to an endpoint (without delaying the GUI, or failing it if the endpoint is unavailable)
+ * @param {string} endpoint URL to send the timings to
+ * @param {string} name The name of the GUI
+ * @internal
+ */
+export function beacon(endpoint: string, name: string): void {
+    const body: string = JSON.stringify({ "gui": name, "timings": timings() });
+    try {
+        if (navigator.sendBeacon(endpoint, body)) {
+            return;
+        }
+    } catch {
+        // Fall back to fetch
+    }
+    fetch(endpoint, { "method": "POST", "body": body, "keepalive": true }).catch((error: any) => {
+        console.warn(`Failed to send timings: ${error}`);
+    });
+}
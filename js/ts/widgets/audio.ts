@@ -1,4 +1,4 @@
-import { loadResource, multimediaResource_t } from "../resources/resource";
+import { multimediaResource_t } from "../resources/resource";
 import { widget_t } from "./widget";
 
 /**
@@ -19,8 +19,8 @@ export class audio_t extends widget_t {
         this.source = (configuration as any).source as string;
     }
     public render(): Promise<HTMLElement> {
-        return new Promise<HTMLElement>((resolve, reject) => {
-            loadResource(this.source).then((resource: multimediaResource_t) => {
+        return this.renderMedia(() => new Promise<HTMLElement>((resolve, reject) => {
+            this.loadMediaResource(this.source).then((resource: multimediaResource_t) => {
                 const failure = (): void => {
                     reject(`An audio resource of type "${resource.mimeType}" is not supported in this browser`);
                 }
@@ -43,6 +43,6 @@ export class audio_t extends widget_t {
                 (this.content as HTMLAudioElement).load();
                 resolve(this.content);
             }).catch((error) => reject(error));
-        });
+        }));
     };
 };
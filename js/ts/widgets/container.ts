@@ -16,6 +16,24 @@ export class container_t extends widget_t {
     constructor() {
         super("fieldset", "container");
     };
+    public discard(): void {
+        super.discard();
+        if (this.object !== undefined) {
+            this.object.discard();
+        }
+    }
+    public detach(): void {
+        super.detach();
+        if (this.object !== undefined) {
+            this.object.detach();
+        }
+    }
+    public attach(): void {
+        super.attach();
+        if (this.object !== undefined) {
+            this.object.attach();
+        }
+    }
     public configuration(configuration: Object): void {
         if (this.configurationHas(configuration, "title")) {
             if ((typeof (configuration as any).title === "string" || typeof (configuration as any).title === "number")) {
@@ -27,19 +45,19 @@ export class container_t extends widget_t {
             throw new Error("A container needs a title");
         }
         if (this.configurationHas(configuration, "object")) {
-            this.object = structure_t.widget((configuration as any).object);
+            this.object = structure_t.widget((configuration as any).object, this.prerenderedChild(1));
         } else {
             throw new Error("A container has no reference to an object");
         }
     }
     public render(): Promise<HTMLElement> {
-        const legend: HTMLLegendElement = document.createElement("legend");
+        const prerenderedLegend: (Element | null) = this.prerenderedChild(0);
+        const legend: HTMLLegendElement = ((prerenderedLegend instanceof HTMLLegendElement) ? prerenderedLegend : document.createElement("legend"));
         legend.textContent = this.title;
-        this.content.appendChild(legend);
         return new Promise<HTMLElement>(async (resolve, reject) => {
             try {
                 const object: HTMLElement = await this.object.render();
-                this.content.appendChild(object);
+                this.placeChildren([legend, object]);
                 resolve(this.content);
             } catch (error) {
                 if (error instanceof RangeError) {
@@ -0,0 +1,40 @@
+import { widget_t } from "./widget";
+
+/**
+ * A stand-in for a widget whose type is declared by a module that is still loading
+ * @internal
+ */
+export class deferred_t extends widget_t {
+    /**
+     * @internal
+     */
+    protected widget!: Promise<widget_t>;
+    /**
+     * Construct a deferred widget
+     * @param {function(): widget_t} create Factory to create (and configure) the actual widget once its type is declared
+     * @param {Promise<void>} modules Promise of all modules having loaded
+     */
+    constructor(create: () => widget_t, modules: Promise<void>) {
+        super("div", "deferred");
+        this.widget = modules.then(() => create());
+        this.widget.catch(() => { }); // Reported when rendered
+    };
+    public discard(): void {
+        super.discard();
+        this.widget.then((widget: widget_t) => widget.discard()).catch(() => { });
+    }
+    public detach(): void {
+        super.detach();
+        this.widget.then((widget: widget_t) => widget.detach()).catch(() => { });
+    }
+    public attach(): void {
+        super.attach();
+        this.widget.then((widget: widget_t) => widget.attach()).catch(() => { });
+    }
+    public configuration(_configuration: Object): void {
+        return; // The actual widget is configured when created
+    }
+    public render(): Promise<HTMLElement> {
+        return this.widget.then((widget: widget_t) => widget.render());
+    };
+};
@@ -1,4 +1,4 @@
-import { loadResource, multimediaResource_t } from "../resources/resource";
+import { multimediaResource_t } from "../resources/resource";
 import { widget_t } from "./widget";
 
 /**
@@ -36,12 +36,12 @@ export class image_t extends widget_t {
         }
     }
     public render(): Promise<HTMLElement> {
-        return new Promise<HTMLElement>((resolve, reject) => {
-            loadResource(this.source).then((resource: multimediaResource_t) => {
+        return this.renderMedia(() => new Promise<HTMLElement>((resolve, reject) => {
+            this.loadMediaResource(this.source).then((resource: multimediaResource_t) => {
                 this.content.onload = () => resolve(this.content);
                 this.content.onerror = () => reject(`An image resource of type "${resource.mimeType}" is not supported in this browser`);
                 (this.content as HTMLImageElement).src = resource.blobUrl;
             }).catch((error) => reject(error));
-        });
+        }));
     };
 };
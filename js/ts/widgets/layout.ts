@@ -20,6 +20,18 @@ export class layout_t extends widget_t {
         super("div", "layout");
         this.children = [];
     };
+    public discard(): void {
+        super.discard();
+        this.children.forEach((child: subWidget_t) => child.discard());
+    }
+    public detach(): void {
+        super.detach();
+        this.children.forEach((child: subWidget_t) => child.detach());
+    }
+    public attach(): void {
+        super.attach();
+        this.children.forEach((child: subWidget_t) => child.attach());
+    }
     public configuration(configuration: Object): void {
         if (!this.configurationHas(configuration, "columns") ||
             !Array.isArray((configuration as any).columns)) {
@@ -36,7 +48,7 @@ export class layout_t extends widget_t {
             if (!Array.isArray((configuration as any).items)) {
                 throw new Error("A layout's `items` must be a list");
             }
-            (configuration as any).items.forEach((item: any) => {
+            (configuration as any).items.forEach((item: any, index: number) => {
                 if (this.children.length == maxItems) {
                     throw new Error("Attempting to add too many items to a layout (consider increasing `columns` or `rows`)");
                 }
@@ -46,7 +58,7 @@ export class layout_t extends widget_t {
                 if (item.object === null) {
                     this.children.push(new void_t());
                 } else {
-                    this.children.push(structure_t.widget(item.object));
+                    this.children.push(structure_t.widget(item.object, this.prerenderedChild(index)));
                 }
             });
         } else {
@@ -107,10 +119,8 @@ export class layout_t extends widget_t {
                 this.children.forEach(child => {
                     childrenPromises.push(child.render());
                 });
-                await Promise.all(childrenPromises).then(async children => {
-                    await children.forEach(async (object) => {
-                        this.content.appendChild(await object);
-                    });
+                await Promise.all(childrenPromises).then(children => {
+                    this.placeChildren(children);
                 });
                 resolve(this.content);
             } catch (error) {
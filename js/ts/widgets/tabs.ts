@@ -21,18 +21,51 @@ export class tabs_t extends widget_t {
      * @internal
      */
     protected tabs!: { [key: string]: subWidget_t };
+    /**
+     * Rendered elements of each tab (shown when its button is clicked)
+     * @internal
+     */
+    protected views!: { [key: string]: HTMLElement };
+    /**
+     * The tab that is shown (null until rendered)
+     * @internal
+     */
+    protected active: (string | null) = null;
     protected position!: tabsPosition_t;
     constructor() {
         super("div", "tabs");
         this.tabs = {};
+        this.views = {};
         this.position = "top";
     };
+    public discard(): void {
+        super.discard();
+        Object.values(this.tabs).forEach((tab: subWidget_t) => tab.discard());
+    }
+    public detach(): void {
+        super.detach();
+        if (this.active !== null) {
+            this.tabs[this.active].detach(); // Hidden tabs are already detached
+        }
+    }
+    public attach(): void {
+        super.attach();
+        if (this.active !== null) {
+            this.tabs[this.active].attach();
+        }
+    }
+    public childReplaced(previous: HTMLElement, next: HTMLElement): void {
+        Object.keys(this.views).filter((tab: string) => this.views[tab] === previous).forEach((tab: string) => {
+            this.views[tab] = next;
+        });
+    }
     public configuration(configuration: Object): void {
         if (!this.configurationHas(configuration, "items") ||
             !Array.isArray((configuration as any).items)) {
             throw new Error("A tabs widget is missing `items`");
         }
-        ((configuration as any).items as Object[]).forEach((item: any) => {
+        const prerenderedView: (Element | null) = this.prerenderedChild(1);
+        ((configuration as any).items as Object[]).forEach((item: any, index: number) => {
             if (!this.configurationHas(item, "name")) {
                 throw new Error("A tab name is expected");
             }
@@ -46,7 +79,8 @@ export class tabs_t extends widget_t {
             if (!this.configurationHas(item, "object")) {
                 throw new Error(`Tab "${tabName}" has no reference to an object`);
             }
-            this.tabs[tabName] = structure_t.widget(item.object);
+            // Only the first tab is pre-rendered (within the tab view)
+            this.tabs[tabName] = structure_t.widget(item.object, ((index == 0 && prerenderedView instanceof HTMLElement) ? this.prerenderedChild(0, prerenderedView) : null));
         });
         if (Object.keys(this.tabs).length == 0) {
             throw new Error("A tabs widget is missing `items`");
@@ -74,8 +108,11 @@ export class tabs_t extends widget_t {
     }
     public render(): Promise<HTMLElement> {
         return new Promise<HTMLElement>(async (resolve, reject) => {
-            const tabButtonContainer: HTMLDivElement = document.createElement("div");
-            const tabView: HTMLDivElement = document.createElement("div");
+            const prerenderedButtonContainer: (Element | null) = this.prerenderedChild(0);
+            const prerenderedView: (Element | null) = this.prerenderedChild(1);
+            const tabButtonContainer: HTMLDivElement = ((prerenderedButtonContainer instanceof HTMLDivElement) ? prerenderedButtonContainer : document.createElement("div"));
+            const tabView: HTMLDivElement = ((prerenderedView instanceof HTMLDivElement) ? prerenderedView : document.createElement("div"));
+            tabButtonContainer.replaceChildren();
             const tabButtons: HTMLButtonElement[] = [];
             let firstTab: boolean = true;
             try {
@@ -86,14 +123,22 @@ export class tabs_t extends widget_t {
                     });
                 await Promise.all(Object.values(tabsPromises));
                 await Object.entries(tabsPromises).forEach(async ([tab, widget]) => {
-                    const tabObject: HTMLElement = await widget;
+                    this.views[tab] = await widget;
                     const tabButton: HTMLButtonElement = document.createElement("button");
                     tabButton.innerText = tab;
                     tabButtons.push(tabButton);
                     tabButtonContainer.appendChild(tabButton);
                     tabButton.addEventListener("click", () => {
-                        if (tabView.firstElementChild !== tabObject) {
-                            tabView.replaceChildren(tabObject);
+                        if (tabView.firstElementChild !== this.views[tab]) {
+                            tabView.replaceChildren(this.views[tab]);
+                        }
+                        if (this.active !== tab) {
+                            // Only the shown tab holds its media resources
+                            if (this.active !== null) {
+                                this.tabs[this.active].detach();
+                            }
+                            this.tabs[tab].attach();
+                            this.active = tab;
                         }
                         tabButtons.forEach((button: HTMLButtonElement) => {
                             if (button !== tabButton) {
@@ -105,10 +150,11 @@ export class tabs_t extends widget_t {
                     if (firstTab) {
                         tabButton.click();
                         firstTab = false;
+                    } else {
+                        this.tabs[tab].detach();
                     }
                 });
-                this.content.appendChild(tabButtonContainer);
-                this.content.appendChild(tabView);
+                this.placeChildren([tabButtonContainer, tabView]);
                 resolve(this.content);
             } catch (error) {
                 if (error instanceof RangeError) {
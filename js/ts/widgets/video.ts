@@ -1,4 +1,4 @@
-import { loadResource, multimediaResource_t } from "../resources/resource";
+import { multimediaResource_t } from "../resources/resource";
 import { widget_t } from "./widget";
 
 /**
@@ -36,8 +36,8 @@ export class video_t extends widget_t {
         }
     };
     public render(): Promise<HTMLElement> {
-        return new Promise<HTMLElement>((resolve, reject) => {
-            loadResource(this.source).then((resource: multimediaResource_t) => {
+        return this.renderMedia(() => new Promise<HTMLElement>((resolve, reject) => {
+            this.loadMediaResource(this.source).then((resource: multimediaResource_t) => {
                 const failure = (): void => {
                     reject(`A video resource of type "${resource.mimeType}" is not supported in this browser`);
                 }
@@ -60,6 +60,6 @@ export class video_t extends widget_t {
                 this.content.onerror = () => failure();
                 (this.content as HTMLVideoElement).load();
             }).catch((error) => reject(error));
-        });
+        }));
     };
 };
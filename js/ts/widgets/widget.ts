@@ -1,11 +1,35 @@
+import { loadResource, multimediaResource_t, promoteResource } from "../resources/resource";
+import { resourcePriority_t, scheduler_t } from "../resources/scheduler";
+
 /**
  * @abstract Base widget class
  */
 export abstract class widget_t {
+    /**
+     * Whether media widgets render placeholders that their media fills in once loaded (rather than delaying the GUI until loaded)
+     * @internal
+     */
+    public static progressive: boolean = false;
     /**
      * Main HTMLElement of the widget
      */
     protected content!: HTMLElement;
+    /**
+     * Whether the main HTMLElement was pre-rendered by the generator (rather than created by the widget)
+     */
+    protected hydrated: boolean = false;
+    /**
+     * Aborted once the widget is discarded (withdrawing its interest in any resources it is loading)
+     */
+    protected discarded: AbortController = new AbortController();
+    /**
+     * Aborted once the widget is detached or discarded (releasing its hold on the media resources it has loaded)
+     */
+    private attachment: AbortController = new AbortController();
+    /**
+     * Media resources that the widget has loaded (keyed by location, with the URL that each was last loaded at)
+     */
+    private media: Map<string, string> = new Map<string, string>();
     /**
      * Construct a base widget
      * @param {string} baseType The base type to construct the widget from
@@ -32,6 +56,156 @@ export abstract class widget_t {
      * @returns {HTMLElement}
      */
     public abstract render(): Promise<HTMLElement>;
+    /**
+     * Discard a widget that will no longer be displayed, cancelling any resources that only it is waiting for
+     */
+    public discard(): void {
+        this.discarded.abort();
+        this.attachment.abort();
+    }
+    /**
+     * Release the media resources of a widget whose element is detached but kept to be shown again (such as within an inactive tab), so that they may be evicted from the resource cache
+     */
+    public detach(): void {
+        this.attachment.abort();
+    }
+    /**
+     * Hold the media resources of a detached widget whose element is shown again, loading any that were evicted meanwhile
+     */
+    public attach(): void {
+        if (!this.attachment.signal.aborted || this.discarded.signal.aborted) {
+            return;
+        }
+        this.attachment = new AbortController();
+        this.media.forEach((previous: string, url: string) => {
+            this.loadMediaResource(url).then((resource: multimediaResource_t) => {
+                if (resource.blobUrl !== previous) {
+                    this.mediaReloaded(previous, resource);
+                }
+            }).catch((error: any) => console.warn(error));
+        });
+    }
+    /**
+     * Apply a media resource that was loaded again after being evicted whilst the widget was detached
+     * @param {string} previous The URL that the resource was previously loaded at
+     * @param {multimediaResource_t} resource The reloaded resource
+     */
+    protected mediaReloaded(previous: string, resource: multimediaResource_t): void {
+        [this.content, ...Array.from(this.content.querySelectorAll("[src]"))].forEach((element: Element) => {
+            if (element.getAttribute("src") === previous) {
+                element.setAttribute("src", resource.blobUrl);
+            }
+        });
+        if (this.content instanceof HTMLMediaElement) {
+            this.content.load();
+        }
+    }
+    /**
+     * Update any reference to the element of a child widget that was replaced in place (such as by a hot update)
+     * @param {HTMLElement} _previous The element of the replaced child widget
+     * @param {HTMLElement} _next The element of the widget that replaced it
+     */
+    public childReplaced(_previous: HTMLElement, _next: HTMLElement): void {
+        return; // Only widgets that keep references to the elements of their children need to update them
+    }
+    /**
+     * Adopt a pre-rendered element as the main HTMLElement of the widget, instead of building it
+     * @param {Element | null | undefined} element The pre-rendered element
+     * @returns {boolean} Whether the element was adopted
+     */
+    public hydrate(element: (Element | null | undefined)): boolean {
+        if (!(element instanceof HTMLElement) || !element.hasAttribute("prerendered") ||
+            element.tagName !== this.content.tagName || element.className !== this.content.className) {
+            return false;
+        }
+        element.removeAttribute("prerendered");
+        this.content = element;
+        this.hydrated = true;
+        return true;
+    }
+    /**
+     * Get a child element that was pre-rendered by the generator
+     * @param {number} index The position of the child element
+     * @param {HTMLElement} parent The element that holds the child element
+     * @returns {Element | null} The child element (if the widget was hydrated)
+     */
+    protected prerenderedChild(index: number, parent: HTMLElement = this.content): (Element | null) {
+        if (!this.hydrated) {
+            return null;
+        }
+        return parent.children.item(index);
+    }
+    /**
+     * Place rendered child elements within a parent, keeping any (hydrated) elements that are already in place
+     * @param {HTMLElement[]} children The rendered child elements in order
+     * @param {HTMLElement} parent The element to place the child elements within
+     */
+    protected placeChildren(children: HTMLElement[], parent: HTMLElement = this.content): void {
+        if (parent.children.length == 0) {
+            // Assemble the children apart from the parent, so they are inserted in one step
+            const fragment: DocumentFragment = document.createDocumentFragment();
+            fragment.append(...children);
+            parent.appendChild(fragment);
+            return;
+        }
+        children.forEach((child: HTMLElement, index: number) => {
+            const current: (Element | null) = parent.children.item(index);
+            if (current === child) {
+                return;
+            }
+            if (current !== null && child.parentElement !== parent) {
+                parent.replaceChild(child, current);
+            } else {
+                parent.insertBefore(child, current);
+            }
+        });
+        while (parent.children.length > children.length) {
+            parent.lastElementChild!.remove();
+        }
+    }
+    /**
+     * Load a media resource of the widget, which is promoted ahead of offscreen media once the main HTMLElement is visible, and held until the widget is detached or discarded
+     * @param {string} url The location of the resource
+     * @returns {Promise<multimediaResource_t>} The loaded resource
+     */
+    protected loadMediaResource(url: string): Promise<multimediaResource_t> {
+        const resource: Promise<multimediaResource_t> = loadResource(url, { "priority": resourcePriority_t.offscreen, "signal": this.discarded.signal, "release": this.attachment.signal });
+        scheduler_t.whenVisible(this.content, () => promoteResource(url, resourcePriority_t.visible), this.discarded.signal);
+        return resource.then((loaded: multimediaResource_t) => {
+            this.media.set(url, loaded.blobUrl);
+            return loaded;
+        });
+    }
+    /**
+     * Render the media of a widget; when rendering progressively, the main HTMLElement is resolved straight away as a placeholder (marked `pending`) that the media fills in once loaded, and a failure is reported on the widget rather than failing the GUI
+     * @param {function(): Promise<HTMLElement>} load Loads the media into the main HTMLElement
+     * @returns {Promise<HTMLElement>} The main HTMLElement
+     */
+    protected renderMedia(load: () => Promise<HTMLElement>): Promise<HTMLElement> {
+        if (!widget_t.progressive) {
+            return load();
+        }
+        this.content.setAttribute("pending", "");
+        load().then(() => {
+            this.content.removeAttribute("pending");
+        }, (error: any) => this.reportFailure(error));
+        return Promise.resolve(this.content);
+    }
+    /**
+     * Report that a widget failed to render, marking its main HTMLElement as `failed` and dispatching a `widgetfailed` event from it (which bubbles)
+     * @param {any} error The reason that the widget failed
+     */
+    protected reportFailure(error: any): void {
+        this.content.removeAttribute("pending");
+        if (this.discarded.signal.aborted) {
+            return; // No longer shown
+        }
+        const reason: string = ((error instanceof Error) ? error.message : `${error}`);
+        this.content.setAttribute("failed", "");
+        this.content.title = reason;
+        console.error(`A ${this.content.className} widget failed to render: ${reason}`);
+        this.content.dispatchEvent(new CustomEvent("widgetfailed", { "bubbles": true, "detail": { "type": this.content.className, "error": reason } }));
+    }
     /**
      * Whether a configuration has an entity
      * @param {Object} configuration Configuration to check against
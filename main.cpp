@@ -1,6 +1,7 @@
 #include "guis.hpp"
 #include <iostream>
 #include <filesystem>
+#include <memory>
 #include <vector>
 
 using namespace sss::guis;
@@ -8,26 +9,83 @@ using namespace sss::guis;
 void print_help()
 {
     std::cout << "Usage: sss-guis [OPTIONS] <CONFIGURATION_FILE> <OUTPUT_DIRECTORY>\n";
+    std::cout << "       sss-guis --batch [OPTIONS] <CONFIGURATION_FILE> <OUTPUT_DIRECTORY> [<CONFIGURATION_FILE> <OUTPUT_DIRECTORY>]...\n";
     std::cout << "Generate SSS powered GUIs from YAML files.\n";
     std::cout << "\n";
     std::cout << "Options:\n";
     std::cout << "  -h, --help                  Display this help message and exit\n";
+    std::cout << "  -a, --archive               Write a single tar archive to <OUTPUT> instead of a directory ('-' for stdout)\n";
+    std::cout << "  -b, --batch                 Generate every pair of arguments in one process (sharing parsed files)\n";
     std::cout << "  -c, --allow-conflicts       Allow dependencies to conflict with generated outputs\n";
     std::cout << "  -f, --flatten-dependencies  Dependencies to not keep parent directory structure\n";
+    std::cout << "      --cache-directory <DIR> Persist parsed widget configuration files in a directory between runs\n";
+    std::cout << "  -l, --log-level <LEVEL>     Limit verbose output up to a level: none, error, warning, info, or debug\n";
+    std::cout << "      --report <FILE>         Write a JSON report of the payload of each GUI to a file\n";
+    std::cout << "  -s, --service-worker        Generate a service worker that precaches all published files\n";
+    std::cout << "      --telemetry <URL>       Send the runtime timings of each loaded GUI to an endpoint\n";
     std::cout << "  -v, --verbose               Enable verbose structural output\n";
+    std::cout << "  -z, --gzip                  Compress the archive with gzip (requires --archive)\n";
     std::cout << "      --version               Show the version of the application\n";
     std::cout << "\n";
     std::cout << "Arguments:\n";
     std::cout << "  <CONFIGURATION_FILE>        A configuration file listing GUIs\n";
-    std::cout << "  <OUTPUT_DIRECTORY>          The directory to output generated GUIs to\n";
+    std::cout << "  <OUTPUT_DIRECTORY>          The directory (or archive with --archive) to output generated GUIs to\n";
 }
 
 bool show_help = false;
+bool archive = false;
+bool batch = false;
+bool compress_archive = false;
 bool allow_conflicts = false;
 bool flatten_dependencies = false;
+bool service_worker = false;
 std::ostream *verbose_stream = nullptr;
+log_level_t log_level = log_level_t::debug;
 std::filesystem::path configuration_file;
 std::filesystem::path output_directory;
+std::vector<batch_entry_t> batch_entries;
+std::filesystem::path cache_directory;
+std::filesystem::path report_file;
+std::string telemetry_endpoint;
+
+/**
+ * @brief Get the value that follows an option
+ * @param argc Amount of arguments
+ * @param argv Arguments
+ * @param index Index of the option (advanced to the value)
+ * @param option The option that requires a value
+ * @return The value of the option
+ */
+std::string option_value(int argc, char const *argv[], int &index, std::string const &option)
+{
+    if (index + 1 >= argc)
+    {
+        std::cerr << "sss-guis: Option requires an argument -- '" << option << "'\n";
+        exit(EXIT_FAILURE);
+    }
+    return argv[++index];
+}
+
+/**
+ * @brief Parse a log level
+ * @param level The name of the level
+ * @return The log level
+ */
+log_level_t parse_log_level(std::string const &level)
+{
+    if (level == "none")
+        return log_level_t::none;
+    if (level == "error")
+        return log_level_t::error;
+    if (level == "warning")
+        return log_level_t::warning;
+    if (level == "info")
+        return log_level_t::info;
+    if (level == "debug")
+        return log_level_t::debug;
+    std::cerr << "sss-guis: Invalid log level -- '" << level << "'\n";
+    exit(EXIT_FAILURE);
+}
 
 void handle_arguments(int argc, char const *argv[])
 {
@@ -45,8 +103,24 @@ void handle_arguments(int argc, char const *argv[])
                     allow_conflicts = true;
                 else if (argument == "--flatten-dependencies")
                     flatten_dependencies = true;
+                else if (argument == "--archive")
+                    archive = true;
+                else if (argument == "--batch")
+                    batch = true;
+                else if (argument == "--gzip")
+                    compress_archive = true;
+                else if (argument == "--service-worker")
+                    service_worker = true;
                 else if (argument == "--verbose")
                     verbose_stream = &(std::cout);
+                else if (argument == "--cache-directory")
+                    cache_directory = option_value(argc, argv, i, argument);
+                else if (argument == "--report")
+                    report_file = option_value(argc, argv, i, argument);
+                else if (argument == "--telemetry")
+                    telemetry_endpoint = option_value(argc, argv, i, argument);
+                else if (argument == "--log-level")
+                    log_level = parse_log_level(option_value(argc, argv, i, argument));
                 else if (argument == "--version")
                 {
                     std::cout << "sss-guis: v" << SSS_GUIS_VERSION_MAJOR << "." << SSS_GUIS_VERSION_MINOR << "." << SSS_GUIS_VERSION_PATCH << "\n";
@@ -74,9 +148,24 @@ void handle_arguments(int argc, char const *argv[])
                     case 'f':
                         flatten_dependencies = true;
                         break;
+                    case 'a':
+                        archive = true;
+                        break;
+                    case 'b':
+                        batch = true;
+                        break;
+                    case 'z':
+                        compress_archive = true;
+                        break;
+                    case 's':
+                        service_worker = true;
+                        break;
                     case 'v':
                         verbose_stream = &(std::cout);
                         break;
+                    case 'l':
+                        log_level = parse_log_level(option_value(argc, argv, i, std::string("-") + character));
+                        break;
                     default:
                         std::cerr << "sss-guis: Invalid option -- '" << character << "'\n";
                         exit(EXIT_FAILURE);
@@ -97,21 +186,64 @@ void handle_arguments(int argc, char const *argv[])
         std::cerr << "sss-guis: Too few arguments\n";
         exit(EXIT_FAILURE);
     }
-    else if (paths.size() > 2)
+    if (compress_archive && !archive)
+    {
+        std::cerr << "sss-guis: Compression requires an archive output\n";
+        exit(EXIT_FAILURE);
+    }
+    if (batch)
+    {
+        if (paths.size() % 2 != 0)
+        {
+            std::cerr << "sss-guis: Batch arguments must be pairs of a configuration file and an output directory\n";
+            exit(EXIT_FAILURE);
+        }
+        if (archive || !report_file.empty())
+        {
+            std::cerr << "sss-guis: Batch mode does not support --archive or --report\n";
+            exit(EXIT_FAILURE);
+        }
+        for (std::size_t i = 0; i < paths.size(); i += 2)
+            batch_entries.push_back({paths[i], paths[i + 1]});
+        return;
+    }
+    if (paths.size() > 2)
     {
         std::cerr << "sss-guis: Too many arguments\n";
         exit(EXIT_FAILURE);
     }
     configuration_file = paths[0];
     output_directory = paths[1];
+    if (archive && output_directory == "-" && verbose_stream != nullptr)
+        verbose_stream = &(std::cerr); // Keep the archive on stdout intact
 }
 
 int main(int argc, char const *argv[])
 {
     handle_arguments(argc, argv);
+    generation_options_t options = {};
+    options.disallow_conflicts = !allow_conflicts;
+    options.flatten_dependency_references = flatten_dependencies;
+    options.debug_stream = verbose_stream;
+    options.log_level = log_level;
+    options.service_worker = service_worker;
+    options.report_file = report_file;
+    options.telemetry_endpoint = telemetry_endpoint;
     try
     {
-        guis_t(configuration_file, output_directory).generate(!allow_conflicts, flatten_dependencies, verbose_stream);
+        if (batch)
+            guis_t::generate_batch(batch_entries, cache_directory, nullptr, options);
+        else if (archive)
+        {
+            std::unique_ptr<archive_output_t> output;
+            if (output_directory == "-")
+                output = std::make_unique<archive_output_t>(std::cout, compress_archive);
+            else
+                output = std::make_unique<archive_output_t>(output_directory, compress_archive);
+            guis_t(configuration_file, *output, cache_directory).generate(options);
+        }
+        else
+            guis_t(configuration_file, output_directory, cache_directory).generate(options);
         return EXIT_SUCCESS;
     }
     catch (const std::exception &e)
@@ -0,0 +1,144 @@
+#include "bundle.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <set>
+#include <stdexcept>
+
+using namespace sss::guis;
+
+namespace
+{
+    /**
+     * @brief Check whether a character can be part of an identifier
+     * @param character The character to check
+     * @return Whether it can be part of an identifier
+     */
+    bool identifier_character(char const character)
+    {
+        return (std::isalnum(static_cast<unsigned char>(character)) || character == '_' || character == '$' || static_cast<unsigned char>(character) >= 0x80);
+    }
+
+    /**
+     * @brief Find the end of a string or template literal
+     * @param script The script holding the literal
+     * @param open The position of the opening quote
+     * @return The position after the closing quote
+     */
+    std::size_t literal_end(std::string const &script, std::size_t const open)
+    {
+        char const quote = script[open];
+        std::size_t position = open + 1;
+        while (position < script.size() && script[position] != quote && (quote == '`' || script[position] != '\n'))
+            position += (script[position] == '\\' ? 2 : 1);
+        return std::min(position + 1, script.size());
+    }
+
+    /**
+     * @brief Check whether a `/` starts a regular expression literal (rather than a division)
+     * @param previous The last significant character before the `/` (`\n` at the start of a line, `\0` at the start of the script)
+     * @param previous_word The word that `previous` ends (empty if it is not part of a word)
+     * @return Whether it starts a regular expression literal
+     */
+    bool regex_start(char const previous, std::string const &previous_word)
+    {
+        static std::set<std::string> const keywords = {"await", "case", "delete", "do", "else", "in", "instanceof", "new", "return", "throw", "typeof", "void", "yield"};
+        if (!previous_word.empty())
+            return (keywords.count(previous_word) != 0);
+        return (previous == '\0' || std::string("\n(,=:[!&|?{};+-*/%<>~^").find(previous) != std::string::npos);
+    }
+
+    /**
+     * @brief Find the end of a regular expression literal
+     * @param script The script holding the literal
+     * @param open The position of the opening `/`
+     * @return The position after its flags
+     */
+    std::size_t regex_end(std::string const &script, std::size_t const open)
+    {
+        bool in_class = false; // A `/` inside `[...]` does not close the literal
+        std::size_t position = open + 1;
+        while (position < script.size() && script[position] != '\n' && (in_class || script[position] != '/'))
+        {
+            if (script[position] == '[')
+                in_class = true;
+            else if (script[position] == ']')
+                in_class = false;
+            position += (script[position] == '\\' ? 2 : 1);
+        }
+        position = std::min(position + 1, script.size());
+        while (position < script.size() && identifier_character(script[position]))
+            position++;
+        return position;
+    }
+
+    /**
+     * @brief Check whether a script uses the `import` or `export` keywords (outside of strings, regular expressions, and comments)
+     * @param script The script to check
+     * @return Whether either keyword is used
+     */
+    bool uses_module_syntax(std::string const &script)
+    {
+        std::size_t position = 0;
+        char previous = '\0';      // The last significant character, to tell a regular expression from a division
+        std::string previous_word; // The word that `previous` ends (if any)
+        while (position < script.size())
+        {
+            char const character = script[position];
+            if (character == '"' || character == '\'' || character == '`')
+            {
+                position = literal_end(script, position);
+                previous = character;
+                previous_word.clear();
+            }
+            else if (script.compare(position, 2, "//") == 0)
+                position = script.find('\n', position);
+            else if (script.compare(position, 2, "/*") == 0)
+            {
+                position = script.find("*/", position + 2);
+                position = (position == std::string::npos ? position : position + 2);
+            }
+            else if (character == '/' && regex_start(previous, previous_word))
+            {
+                position = regex_end(script, position);
+                previous = ')'; // Ends an expression, like a closing parenthesis
+                previous_word.clear();
+            }
+            else if (identifier_character(character))
+            {
+                std::size_t const start = position;
+                while (position < script.size() && identifier_character(script[position]))
+                    position++;
+                std::string const word = script.substr(start, position - start);
+                bool const property = (start > 0 && script[start - 1] == '.'); // Such as `object.import`
+                if (!property && (word == "import" || word == "export"))
+                    return true;
+                previous = word.back();
+                previous_word = (property ? std::string() : word);
+            }
+            else
+            {
+                if (character == '\n' || !std::isspace(static_cast<unsigned char>(character)))
+                {
+                    previous = character;
+                    previous_word.clear();
+                }
+                position++;
+            }
+        }
+        return false;
+    }
+}
+
+std::string sss::guis::bundle_module_files(std::vector<std::filesystem::path> const &files, input_t const &input)
+{
+    std::string bundle;
+    for (auto const &file : files)
+    {
+        std::string const module = input.read(file);
+        if (uses_module_syntax(module))
+            throw std::runtime_error("Unable to bundle the module \"" + file.string() + "\" since it uses `import` or `export`");
+        bundle += "{\n" + module + "\n}\n";
+    }
+    return bundle;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "input.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace sss::guis
+{
+    /**
+     * @brief Bundle modules into a single module, which evaluates each of them in turn (in the order given)
+     *
+     * Each module is wrapped in its own block, so that their top-level declarations cannot collide. Modules that use `import` or `export` cannot be bundled this way, as they would resolve relative to the bundle rather than themselves
+     * @param files The absolute paths of the modules
+     * @param input The input to read the modules from
+     * @return The bundled module
+     * @throw std::runtime_error If a module uses `import` or `export`
+     */
+    std::string bundle_module_files(std::vector<std::filesystem::path> const &files, input_t const &input);
+}
@@ -0,0 +1,406 @@
+#include "cache.hpp"
+#include "hash.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+using namespace sss::guis;
+
+namespace
+{
+    /**
+     * @brief Identifies a cache entry (and the version of its format)
+     */
+    std::string const entry_signature = "SSSGUIS\x02";
+
+    /**
+     * @brief Identifies a cache entry of a built structure (and the version of its format)
+     */
+    std::string const structure_entry_signature = "SSSGUIS-STRUCTURE\x01";
+
+    /**
+     * @brief Deep copy records (widget contents are modified once they are numbered, so callers never share nodes)
+     * @param documents The records to copy
+     * @return The copied records
+     */
+    std::vector<document_record_t> clone_documents(std::vector<document_record_t> const &documents)
+    {
+        // Records are rebuilt rather than assigned, since assigning to a copied node would rebind the node it shares with the original
+        std::vector<document_record_t> cloned = {};
+        for (auto const &document : documents)
+        {
+            document_record_t copy = {{}, document.dependencies};
+            for (auto const &widget : document.widgets)
+                copy.widgets.push_back({widget.name, widget.type, YAML::Clone(widget.contents)});
+            cloned.push_back(copy);
+        }
+        return cloned;
+    }
+
+    /**
+     * @brief Get the key of a file within the records held in memory
+     * @param file The file
+     * @return The key of the file
+     */
+    std::filesystem::path memory_key(std::filesystem::path const &file)
+    {
+        return std::filesystem::absolute(file).lexically_normal();
+    }
+
+    /**
+     * @brief Tags describing the kind of a serialized YAML node
+     */
+    enum node_tag_t : unsigned char
+    {
+        node_tag_null = 0,
+        node_tag_scalar = 1,
+        node_tag_sequence = 2,
+        node_tag_map = 3,
+    };
+
+    /**
+     * @brief Read the entire contents of a file
+     * @param file The file to read
+     * @return The contents of the file
+     */
+    std::string read_file(std::filesystem::path const &file)
+    {
+        std::ifstream stream(file, std::ios::binary);
+        if (!stream)
+            throw std::runtime_error("Failed to open file for reading: " + file.string());
+        return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    /**
+     * @brief Write a cache entry (written then renamed so that concurrent readers never see a partial entry)
+     * @param entry The location of the cache entry
+     * @param buffer The contents of the cache entry
+     */
+    void write_entry(std::filesystem::path const &entry, std::string const &buffer)
+    {
+        // The random suffix keeps processes sharing a cache directory (such as CI jobs restoring the same cache) from writing the same file
+        std::uint64_t const suffix = (static_cast<std::uint64_t>(std::random_device()()) << 32) ^ std::hash<std::thread::id>()(std::this_thread::get_id());
+        std::filesystem::path const temporary = entry.string() + "." + hash_to_string(suffix) + ".tmp";
+        bool written = false;
+        {
+            std::ofstream stream(temporary, std::ios::binary | std::ios::out | std::ios::trunc);
+            if (stream)
+            {
+                stream.write(buffer.data(), buffer.size());
+                stream.close();
+                written = !stream.fail();
+            }
+        }
+        std::error_code error;
+        if (written)
+            std::filesystem::rename(temporary, entry, error);
+        if (!written || error)
+            std::filesystem::remove(temporary, error); // Never leave a partial entry behind
+    }
+
+    /**
+     * @brief Serializes values into a compact binary form
+     */
+    class writer_t
+    {
+    public:
+        std::string buffer;
+        void integer(std::uint64_t value)
+        {
+            // LEB128 variable length integer
+            do
+            {
+                unsigned char byte = static_cast<unsigned char>(value & 0x7F);
+                value >>= 7;
+                if (value != 0)
+                    byte |= 0x80;
+                buffer.push_back(static_cast<char>(byte));
+            } while (value != 0);
+        }
+        void string(std::string const &value)
+        {
+            integer(value.size());
+            buffer += value;
+        }
+        void node(YAML::Node const &value)
+        {
+            if (value.IsScalar())
+            {
+                buffer.push_back(static_cast<char>(node_tag_scalar));
+                string(value.Scalar());
+            }
+            else if (value.IsSequence())
+            {
+                buffer.push_back(static_cast<char>(node_tag_sequence));
+                integer(value.size());
+                for (auto const &item : value)
+                    node(item);
+            }
+            else if (value.IsMap())
+            {
+                buffer.push_back(static_cast<char>(node_tag_map));
+                integer(value.size());
+                for (auto const &item : value)
+                {
+                    node(item.first);
+                    node(item.second);
+                }
+            }
+            else
+                buffer.push_back(static_cast<char>(node_tag_null));
+        }
+    };
+
+    /**
+     * @brief Deserializes values written by `writer_t`
+     */
+    class reader_t
+    {
+    private:
+        std::string const &m_buffer;
+        std::size_t m_position;
+
+    public:
+        reader_t(std::string const &buffer, std::size_t const position = 0) : m_buffer(buffer), m_position(position) {}
+        unsigned char byte()
+        {
+            if (m_position >= m_buffer.size())
+                throw std::runtime_error("Truncated cache entry");
+            return static_cast<unsigned char>(m_buffer[m_position++]);
+        }
+        std::uint64_t integer()
+        {
+            std::uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                unsigned char const current = byte();
+                value |= (static_cast<std::uint64_t>(current & 0x7F) << shift);
+                if ((current & 0x80) == 0)
+                    return value;
+            }
+            throw std::runtime_error("Malformed cache entry");
+        }
+        std::string string()
+        {
+            std::uint64_t const length = integer();
+            if (length > m_buffer.size() - m_position)
+                throw std::runtime_error("Truncated cache entry");
+            std::string value = m_buffer.substr(m_position, length);
+            m_position += length;
+            return value;
+        }
+        YAML::Node node()
+        {
+            switch (byte())
+            {
+            case node_tag_null:
+                return YAML::Node(YAML::NodeType::Null);
+            case node_tag_scalar:
+                return YAML::Node(string());
+            case node_tag_sequence:
+            {
+                YAML::Node sequence(YAML::NodeType::Sequence);
+                for (std::uint64_t i = integer(); i > 0; i--)
+                    sequence.push_back(node());
+                return sequence;
+            }
+            case node_tag_map:
+            {
+                YAML::Node map(YAML::NodeType::Map);
+                for (std::uint64_t i = integer(); i > 0; i--)
+                {
+                    YAML::Node key = node();
+                    map[key] = node();
+                }
+                return map;
+            }
+            default:
+                throw std::runtime_error("Malformed cache entry");
+            }
+        }
+        std::size_t position() const
+        {
+            return m_position;
+        }
+    };
+}
+
+cache_t::cache_t(std::filesystem::path const &directory, input_t const &input)
+    : m_directory(directory.empty() ? directory : std::filesystem::absolute(directory.lexically_normal())),
+      m_input(input)
+{
+    if (!enabled())
+        return;
+    if (!std::filesystem::exists(m_directory))
+    {
+        if (!std::filesystem::create_directories(m_directory))
+            throw std::runtime_error("Failed to create cache directory");
+    }
+    else if (!std::filesystem::is_directory(m_directory))
+        throw std::runtime_error("There is already a file located as the cache directory location");
+}
+
+cache_t::~cache_t()
+{
+}
+
+bool cache_t::enabled() const
+{
+    return !m_directory.empty();
+}
+
+std::filesystem::path cache_t::entry_path(std::uint64_t const hash) const
+{
+    return m_directory / (hash_to_string(hash) + ".bin");
+}
+
+std::filesystem::path cache_t::structure_entry_path(std::string const &key) const
+{
+    return m_directory / (hash_to_string(hash_contents(key)) + ".structure.bin");
+}
+
+bool cache_t::load(std::filesystem::path const &file, std::vector<document_record_t> &documents, std::string &contents) const
+{
+    // A matching size and modification time do not guarantee the same contents, so every hit is checked against the contents' hash
+    contents = m_input.read(file);
+    std::uint64_t const contents_hash = hash_contents(contents);
+    {
+        std::lock_guard<std::mutex> const lock(m_memory_mutex);
+        auto const found = m_memory.find(memory_key(file));
+        if (found != m_memory.end() && found->second.hash == contents_hash)
+        {
+            documents = clone_documents(found->second.documents);
+            return true;
+        }
+    }
+    if (!enabled())
+        return false;
+    try
+    {
+        std::filesystem::path const entry = entry_path(contents_hash);
+        if (!std::filesystem::exists(entry))
+            return false;
+        std::string const buffer = read_file(entry);
+        if (buffer.compare(0, entry_signature.size(), entry_signature) != 0)
+            return false;
+        reader_t reader(buffer, entry_signature.size());
+        std::uint64_t const size = reader.integer();
+        std::uint64_t const hash = reader.integer();
+        if (size != contents.size() || hash != contents_hash)
+            return false; // Other contents share the same entry
+
+        std::vector<document_record_t> loaded = {};
+        for (std::uint64_t i = reader.integer(); i > 0; i--)
+        {
+            document_record_t document = {};
+            for (std::uint64_t ii = reader.integer(); ii > 0; ii--)
+            {
+                widget_record_t widget = {};
+                widget.name = reader.string();
+                widget.type = reader.string();
+                widget.contents = reader.node();
+                document.widgets.push_back(widget);
+            }
+            for (std::uint64_t ii = reader.integer(); ii > 0; ii--)
+                document.dependencies.push_back(reader.string());
+            loaded.push_back(document);
+        }
+        if (reader.position() != buffer.size())
+            return false;
+        documents = loaded;
+        std::lock_guard<std::mutex> const lock(m_memory_mutex);
+        m_memory[memory_key(file)] = {contents_hash, clone_documents(documents)};
+        return true;
+    }
+    catch (std::exception const &e)
+    {
+        return false; // An unusable entry is treated as a miss
+    }
+}
+
+void cache_t::store(std::filesystem::path const &file, std::string const &contents, std::vector<document_record_t> const &documents) const
+{
+    {
+        std::lock_guard<std::mutex> const lock(m_memory_mutex);
+        m_memory[memory_key(file)] = {hash_contents(contents), clone_documents(documents)};
+    }
+    if (!enabled())
+        return;
+    try
+    {
+        writer_t writer;
+        writer.buffer = entry_signature;
+        writer.integer(contents.size());
+        writer.integer(hash_contents(contents));
+        writer.integer(documents.size());
+        for (auto const &document : documents)
+        {
+            writer.integer(document.widgets.size());
+            for (auto const &widget : document.widgets)
+            {
+                writer.string(widget.name);
+                writer.string(widget.type);
+                writer.node(widget.contents);
+            }
+            writer.integer(document.dependencies.size());
+            for (auto const &dependency : document.dependencies)
+                writer.string(dependency);
+        }
+
+        write_entry(entry_path(hash_contents(contents)), writer.buffer);
+    }
+    catch (std::exception const &e)
+    {
+        // The cache is best effort, so failing to store an entry is not an error
+    }
+}
+
+bool cache_t::load_structure(std::string const &key, std::string &structure) const
+{
+    if (!enabled())
+        return false;
+    try
+    {
+        std::filesystem::path const entry = structure_entry_path(key);
+        if (!std::filesystem::exists(entry))
+            return false;
+        std::string const buffer = read_file(entry);
+        if (buffer.compare(0, structure_entry_signature.size(), structure_entry_signature) != 0)
+            return false;
+        reader_t reader(buffer, structure_entry_signature.size());
+        if (reader.string() != key)
+            return false; // Another structure shares the same entry
+        std::string const loaded = reader.string();
+        if (reader.position() != buffer.size())
+            return false;
+        structure = loaded;
+        return true;
+    }
+    catch (std::exception const &e)
+    {
+        return false; // An unusable entry is treated as a miss
+    }
+}
+
+void cache_t::store_structure(std::string const &key, std::string const &structure) const
+{
+    if (!enabled())
+        return;
+    try
+    {
+        writer_t writer;
+        writer.buffer = structure_entry_signature;
+        writer.string(key);
+        writer.string(structure);
+        write_entry(structure_entry_path(key), writer.buffer);
+    }
+    catch (std::exception const &e)
+    {
+        // The cache is best effort, so failing to store an entry is not an error
+    }
+}
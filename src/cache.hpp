@@ -0,0 +1,140 @@
+#pragma once
+
+#include "input.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+namespace sss::guis
+{
+    /**
+     * @brief A widget as declared in a widget configuration file
+     */
+    struct widget_record_t
+    {
+        /**
+         * @brief The name of the widget
+         */
+        std::string name;
+        /**
+         * @brief The type of the widget
+         */
+        std::string type;
+        /**
+         * @brief The contents of the widget (without `type`)
+         */
+        YAML::Node contents;
+    };
+
+    /**
+     * @brief A YAML document within a widget configuration file
+     */
+    struct document_record_t
+    {
+        /**
+         * @brief Widgets declared in the document
+         */
+        std::vector<widget_record_t> widgets;
+        /**
+         * @brief Declared dependencies of the document (as written)
+         */
+        std::vector<std::string> dependencies;
+    };
+
+    class cache_t
+    {
+    private:
+        /**
+         * @brief Records of a file held in memory (valid while the file keeps its contents)
+         */
+        struct memory_entry_t
+        {
+            /**
+             * @brief The hash of the contents of the file when it was parsed
+             */
+            std::uint64_t hash;
+            /**
+             * @brief The records of the file
+             */
+            std::vector<document_record_t> documents;
+        };
+        /**
+         * @brief The directory that cache entries are stored in (empty if caching is disabled)
+         */
+        std::filesystem::path const m_directory;
+        /**
+         * @brief The input that cached files are read from
+         */
+        input_t const &m_input;
+        /**
+         * @brief Records of files parsed during this run (shared by every generation that uses the cache)
+         */
+        mutable std::map<std::filesystem::path, memory_entry_t> m_memory;
+        /**
+         * @brief Guards `m_memory`
+         */
+        mutable std::mutex m_memory_mutex;
+        /**
+         * @brief Get the location of the cache entry of a file's contents (so that it does not depend on where the file is checked out)
+         * @param hash The hash of the contents of the file
+         * @return Location of the cache entry
+         */
+        std::filesystem::path entry_path(std::uint64_t const hash) const;
+        /**
+         * @brief Get the location of the cache entry of a built structure
+         * @param key Identifies the GUI that the structure was built for
+         * @return Location of the cache entry
+         */
+        std::filesystem::path structure_entry_path(std::string const &key) const;
+
+    public:
+        /**
+         * @brief Construct a cache of parsed widget configuration files (held in memory for the lifetime of the cache, and persisted if a directory is given)
+         * @param directory The directory to store cache entries in (if empty then nothing is persisted)
+         * @param input The input that cached files are read from
+         */
+        cache_t(std::filesystem::path const &directory, input_t const &input);
+        /**
+         * @brief Deconstructor
+         */
+        ~cache_t();
+        /**
+         * @brief Whether cache entries are persisted
+         * @return Whether cache entries are persisted
+         */
+        bool enabled() const;
+        /**
+         * @brief Load the records of a file, if it was already parsed in this run or a valid cache entry exists for it
+         * @param file The file to load the records of
+         * @param documents The loaded records
+         * @param contents The contents of the file (read to validate entries, so a miss can parse them without reading the file again)
+         * @return Whether records were loaded
+         */
+        bool load(std::filesystem::path const &file, std::vector<document_record_t> &documents, std::string &contents) const;
+        /**
+         * @brief Store the records of a file
+         * @param file The file that the records were parsed from
+         * @param contents The contents of the file that were parsed
+         * @param documents The records to store
+         */
+        void store(std::filesystem::path const &file, std::string const &contents, std::vector<document_record_t> const &documents) const;
+        /**
+         * @brief Load the structure that was last built for a GUI (in an earlier run), if caching is enabled
+         * @param key Identifies the GUI
+         * @param structure The loaded structure
+         * @return Whether a structure was loaded
+         */
+        bool load_structure(std::string const &key, std::string &structure) const;
+        /**
+         * @brief Store the structure built for a GUI, so that a later run can describe how it changed
+         * @param key Identifies the GUI
+         * @param structure The built structure
+         */
+        void store_structure(std::string const &key, std::string const &structure) const;
+    };
+}
@@ -0,0 +1,127 @@
+#include "delta.hpp"
+#include "hash.hpp"
+
+#include <map>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+using namespace sss::guis;
+
+namespace
+{
+    /**
+     * @brief A widget of a built structure
+     * @first The type of the widget
+     * @second The expanded configuration of the widget
+     */
+    using expanded_widget_t = std::pair<std::string, nlohmann::json>;
+
+    /**
+     * @brief Expand a minified configuration (restoring interned keys and shared subtrees)
+     * @param configuration The configuration to expand
+     * @param keys The key dictionary of the structure (`null` if the structure was not minified)
+     * @param shared The shared subtrees of the structure
+     * @return The expanded configuration
+     */
+    nlohmann::json expand(nlohmann::json const &configuration, nlohmann::json const &keys, nlohmann::json const &shared)
+    {
+        if (keys.is_null() || configuration.is_primitive())
+            return configuration;
+        if (configuration.is_array())
+        {
+            nlohmann::json expanded = nlohmann::json::array();
+            for (auto const &item : configuration)
+                expanded.push_back(expand(item, keys, shared));
+            return expanded;
+        }
+        if (configuration.contains(""))
+            return expand(shared.at(configuration.at("").get<std::size_t>()), keys, shared);
+        nlohmann::json expanded = nlohmann::json::object();
+        for (auto const &entry : configuration.items())
+            expanded[keys.at(std::stoul(entry.key())).get<std::string>()] = expand(entry.value(), keys, shared);
+        return expanded;
+    }
+
+    /**
+     * @brief Expand every widget of a built structure
+     * @param structure The built structure
+     * @param numeric Whether the structure uses numeric widget identifiers
+     * @return The widgets (keyed by identifier, as a string for numeric identifiers)
+     */
+    std::map<std::string, expanded_widget_t> expand_widgets(nlohmann::json const &structure, bool &numeric)
+    {
+        nlohmann::json const &widgets = structure.at("widgets");
+        nlohmann::json const &types = structure.at("types");
+        nlohmann::json const keys = structure.value("keys", nlohmann::json());
+        nlohmann::json const shared = structure.value("shared", nlohmann::json::array());
+        numeric = widgets.is_array();
+        std::map<std::string, expanded_widget_t> expanded = {};
+        for (auto const &entry : widgets.items())
+        {
+            nlohmann::json const &widget = entry.value();
+            expanded.emplace(entry.key(), expanded_widget_t(types.at(widget.at(0).get<std::size_t>()).get<std::string>(), expand(widget.at(1), keys, shared)));
+        }
+        return expanded;
+    }
+}
+
+std::string sss::guis::structure_version(std::string const &structure)
+{
+    return hash_to_string(hash_contents(structure));
+}
+
+std::string sss::guis::structure_delta(std::string const &previous, std::string const &current)
+{
+    std::map<std::string, expanded_widget_t> previous_widgets;
+    std::map<std::string, expanded_widget_t> current_widgets;
+    nlohmann::json current_json;
+    bool previous_numeric = false;
+    bool current_numeric = false;
+    try
+    {
+        previous_widgets = expand_widgets(nlohmann::json::parse(previous), previous_numeric);
+        current_json = nlohmann::json::parse(current);
+        current_widgets = expand_widgets(current_json, current_numeric);
+    }
+    catch (nlohmann::json::exception const &e)
+    {
+        throw std::runtime_error(std::string("Unable to compare structures since one is malformed: ") + e.what());
+    }
+    if (previous_numeric != current_numeric)
+        throw std::runtime_error("Unable to compare structures since only one uses numeric widget identifiers");
+
+    nlohmann::json const &types = current_json.at("types");
+    std::map<std::string, std::size_t> type_indices = {};
+    for (std::size_t i = 0; i < types.size(); ++i)
+        type_indices.emplace(types[i].get<std::string>(), i);
+
+    nlohmann::json changed = nlohmann::json::object();
+    for (auto const &widget : current_widgets)
+    {
+        auto const found = previous_widgets.find(widget.first);
+        if (found == previous_widgets.end() || found->second != widget.second)
+            changed[widget.first] = nlohmann::json::array({type_indices.at(widget.second.first), widget.second.second});
+    }
+    nlohmann::json removed = nlohmann::json::array();
+    for (auto const &widget : previous_widgets)
+    {
+        if (current_widgets.count(widget.first) == 0)
+        {
+            if (current_numeric)
+                removed.push_back(std::stoul(widget.first));
+            else
+                removed.push_back(widget.first);
+        }
+    }
+
+    nlohmann::json const delta = {
+        {"base", structure_version(previous)},
+        {"version", structure_version(current)},
+        {"types", types},
+        {"main", current_json.at("main")},
+        {"order", current_json.value("order", nlohmann::json())},
+        {"depth", current_json.value("depth", nlohmann::json())},
+        {"widgets", changed},
+        {"removed", removed}};
+    return delta.dump();
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+namespace sss::guis
+{
+    /**
+     * @brief Get the version of a built structure (changes whenever the structure changes)
+     * @param structure The built structure
+     * @return The version
+     */
+    std::string structure_version(std::string const &structure);
+
+    /**
+     * @brief Describe the changes between two builds of a structure, so that a runtime showing the previous build can update to the current one without fetching it whole
+     *
+     * The delta holds the current `types`, `main`, `order`, and `depth`; the expanded configurations of widgets that were added or changed (`widgets`, keyed by identifier); the identifiers of widgets that were removed (`removed`); and the versions it updates from and to (`base` and `version`)
+     * @param previous The previously built structure
+     * @param current The currently built structure
+     * @return The delta (as JSON)
+     * @throw std::runtime_error If either structure is malformed, or they do not use the same kind of widget identifiers
+     */
+    std::string structure_delta(std::string const &previous, std::string const &current);
+}
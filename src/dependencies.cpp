@@ -50,8 +50,9 @@ namespace
     }
 }
 
-dependencies_t::dependencies_t(std::filesystem::path const &path)
-    : m_path(path)
+dependencies_t::dependencies_t(std::filesystem::path const &path, input_t const &input)
+    : m_path(path),
+      m_input(input)
 {
 }
 
@@ -61,7 +62,7 @@ dependencies_t::~dependencies_t()
 
 std::vector<std::filesystem::path> dependencies_t::paths()
 {
-    if (std::filesystem::exists(m_path))
+    if (m_input.status(m_path).exists)
         return {m_path};
     std::vector<std::filesystem::path> existing_paths = {};
 
@@ -70,11 +71,11 @@ std::vector<std::filesystem::path> dependencies_t::paths()
     std::filesystem::path const start_directory = get_starting_directory_from_wildcard_path(m_path);
     try
     {
-        for (auto const &entry : std::filesystem::recursive_directory_iterator(start_directory))
+        for (auto const &file : m_input.list(start_directory))
         {
-            std::filesystem::path relative_entry_path = std::filesystem::relative(entry.path(), start_directory);
-            if (std::regex_match((start_directory / relative_entry_path).string(), path_regex) && std::filesystem::is_regular_file(entry.path()))
-                    existing_paths.push_back(entry.path());
+            std::filesystem::path relative_file_path = file.lexically_relative(start_directory);
+            if (std::regex_match((start_directory / relative_file_path).string(), path_regex))
+                existing_paths.push_back(file);
         }
     }
     catch (std::filesystem::filesystem_error const &e)
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "input.hpp"
+
 #include <filesystem>
 #include <vector>
 
@@ -12,13 +14,18 @@ namespace sss::guis
          * @brief The path to evaluate against
          */
         std::filesystem::path const m_path;
+        /**
+         * @brief The input to find paths within
+         */
+        input_t const &m_input;
 
     public:
         /**
          * @brief Construct a dependency tree
          * @param path The path to evaluate (support * and ? wildcards)
+         * @param input The input to find paths within
          */
-        dependencies_t(std::filesystem::path const &path);
+        dependencies_t(std::filesystem::path const &path, input_t const &input);
         /**
          * @brief Deconstructor
          */
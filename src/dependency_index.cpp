@@ -0,0 +1,78 @@
+#include "dependency_index.hpp"
+
+#include <unordered_set>
+
+using namespace sss::guis;
+
+dependency_index_t::dependency_index_t(std::map<std::filesystem::path, std::filesystem::path> const &dependencies)
+    : m_dependencies(dependencies),
+      m_root()
+{
+    for (auto const &dependency : m_dependencies)
+    {
+        node_t *node = &m_root;
+        for (auto const &component : dependency.first)
+        {
+            std::unique_ptr<node_t> &child = node->children[component.string()];
+            if (!child)
+                child = std::make_unique<node_t>();
+            node = child.get();
+        }
+        node->terminal = true;
+    }
+}
+
+dependency_index_t::~dependency_index_t()
+{
+}
+
+std::vector<std::string> dependency_index_t::conflicts(std::vector<std::filesystem::path> const &generated_files, std::vector<std::filesystem::path> const &existing_files, bool const flatten_dependency_references) const
+{
+    std::unordered_set<std::string> generated = {};
+    for (auto const &generated_file : generated_files)
+        generated.insert(generated_file.lexically_normal().string());
+    std::unordered_set<std::string> existing = {};
+    for (auto const &existing_file : existing_files)
+        existing.insert(existing_file.lexically_normal().string());
+
+    std::vector<std::string> found = {};
+    std::unordered_map<std::string, std::filesystem::path> flattened = {};
+    for (auto const &dependency : m_dependencies)
+    {
+        std::filesystem::path const &dependency_source = dependency.first;
+        std::filesystem::path const &dependency_destination = dependency.second;
+        std::string const destination = (flatten_dependency_references ? dependency_destination.filename() : dependency_destination.lexically_normal()).string();
+        if (generated.count(destination))
+            found.push_back("A dependency of \"" + dependency_destination.string() + "\" will conflict with an automatically generated file");
+        if (existing.count(destination))
+            found.push_back("A dependency of \"" + dependency_source.string() + "\" will conflict with an already existing file");
+        if (flatten_dependency_references)
+        {
+            // Check if output dependencies will conflict with each other when filenames are flattened
+            std::string const filename = dependency_source.filename().string();
+            if (!flattened.emplace(filename, dependency_source).second)
+                found.push_back("Conflicting filename of \"" + filename + "\" between flattened dependencies");
+        }
+    }
+    return found;
+}
+
+std::vector<std::filesystem::path> dependency_index_t::descendants() const
+{
+    std::vector<std::filesystem::path> found = {};
+    for (auto const &dependency : m_dependencies)
+    {
+        node_t const *node = &m_root;
+        auto component = dependency.first.begin();
+        auto const end = dependency.first.end();
+        for (; component != end; ++component)
+        {
+            if (node->terminal)
+                break; // An ancestor is itself a dependency
+            node = node->children.at(component->string()).get();
+        }
+        if (component != end)
+            found.push_back(dependency.first);
+    }
+    return found;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sss::guis
+{
+    class dependency_index_t
+    {
+    private:
+        /**
+         * @brief A single path component within the trie
+         */
+        struct node_t
+        {
+            /**
+             * @brief Child path components
+             */
+            std::unordered_map<std::string, std::unique_ptr<node_t>> children;
+            /**
+             * @brief Whether a dependency ends at this component
+             */
+            bool terminal = false;
+        };
+        /**
+         * @brief Dependency sources and their output destinations
+         */
+        std::map<std::filesystem::path, std::filesystem::path> const &m_dependencies;
+        /**
+         * @brief Trie of dependency source paths
+         */
+        node_t m_root;
+
+    public:
+        /**
+         * @brief Construct an index of dependencies
+         * @param dependencies Dependency sources and their output destinations (must outlive the index)
+         */
+        dependency_index_t(std::map<std::filesystem::path, std::filesystem::path> const &dependencies);
+        /**
+         * @brief Deconstructor
+         */
+        ~dependency_index_t();
+        /**
+         * @brief Find every conflict of the dependencies in a single pass
+         * @param generated_files Output paths of generated files
+         * @param existing_files Output paths that already exist
+         * @param flatten_dependency_references Whether dependency output files are flattened to just their filename
+         * @return Descriptions of all conflicts found
+         */
+        std::vector<std::string> conflicts(std::vector<std::filesystem::path> const &generated_files, std::vector<std::filesystem::path> const &existing_files, bool const flatten_dependency_references) const;
+        /**
+         * @brief Find dependencies that are within the source directory of another dependency
+         * @return Sources of descendant dependencies
+         */
+        std::vector<std::filesystem::path> descendants() const;
+    };
+}
@@ -1,7 +1,13 @@
+#include "bundle.hpp"
+#include "delta.hpp"
 #include "dependencies.hpp"
+#include "dependency_index.hpp"
 #include "generation.hpp"
-#include "guis.js.hpp" // Generated file
+#include "guis.js.hpp"                // Generated file
+#include "guis.service-worker.js.hpp" // Generated file
+#include "hash.hpp"
 #include "structure.hpp"
+#include "stylesheet.hpp"
 
 #include <algorithm>
 #include <filesystem>
@@ -17,6 +23,11 @@ using namespace sss::guis;
 
 namespace
 {
+    /**
+     * @brief Output path of the service worker (it must be at the root to control every GUI)
+     */
+    std::string const service_worker_filename = "service-worker.js";
+
     /**
      * @brief Check if a string is empty
      * @param string The string to check
@@ -28,53 +39,14 @@ namespace
                            { return std::isspace(character); });
     }
 
-    /**
-     * @brief Checks if a filepath is a descendant of another filepath
-     * @param parent Filepath
-     * @param child Filepath
-     * @returns If the child path is a descendant of the parent
-     */
-    bool is_descendant(std::filesystem::path const &parent, std::filesystem::path const &child)
-    {
-        auto const [parent_iterator, child_iterator] = std::mismatch(parent.begin(), parent.end(), child.begin(), child.end());
-        // Descendant if we exhausted parent but NOT child
-        return (parent_iterator == parent.end() && child_iterator != child.end());
-    }
-
-    /**
-     * @brief Removes any filepaths that are descendants of any filepaths in a vector
-     * @param paths A vector of filepaths
-     * @returns A vector of filepaths with descendant filepaths removed
-     */
-    std::vector<std::filesystem::path> const remove_descendant_paths(std::vector<std::filesystem::path> &paths)
-    {
-        // Sort the paths to ensure parent paths come before their descendants
-        std::sort(paths.begin(), paths.end());
-
-        std::vector<std::filesystem::path> unique_paths = {};
-        if (paths.empty())
-            return unique_paths;
-
-        unique_paths.push_back(paths[0]); // Add the first path as it's the most "parental" initially
-
-        for (auto const &path : paths)
-        {
-            if (std::find(unique_paths.begin(), unique_paths.end(), path) != unique_paths.end())
-                continue;
-            // Check if the current path is a descendant of the last unique path found
-            if (!is_descendant(unique_paths.back(), path))
-                unique_paths.push_back(path); // Keep if not a descendant
-        }
-        return unique_paths;
-    }
-
     /**
      * @brief Convert a relative filepath to an absolute filepath
      * @param target_path The filepath to make absolute against `base_path`
      * @param base_path The base filepath to perform evaluation against
+     * @param input The input that resolves canonical paths
      * @return Absolute filepath
      */
-    std::filesystem::path convert_relative_path_to_absolute(std::filesystem::path const &target_path, std::filesystem::path const &base_path)
+    std::filesystem::path convert_relative_path_to_absolute(std::filesystem::path const &target_path, std::filesystem::path const &base_path, input_t const &input)
     {
         std::filesystem::path base_directory = std::filesystem::absolute(base_path).parent_path();
         std::filesystem::path absolute_target_path;
@@ -82,19 +54,20 @@ namespace
             absolute_target_path = target_path;
         else
             absolute_target_path = base_directory / target_path;
-        return std::filesystem::absolute(base_directory / std::filesystem::relative(absolute_target_path, base_directory)).lexically_normal();
+        return std::filesystem::absolute(base_directory / input.canonical(absolute_target_path).lexically_relative(input.canonical(base_directory))).lexically_normal();
     }
 
     /**
      * @brief Get a filepath relative to another
      * @param target_path The filepath to make absolute against `base_path`
      * @param base_path The base filepath to perform evaluation against
+     * @param input The input that resolves canonical paths
      * @return Relative filepath
      */
-    std::filesystem::path convert_absolute_path_to_relative(std::filesystem::path const &target_path, std::filesystem::path const &base_path)
+    std::filesystem::path convert_absolute_path_to_relative(std::filesystem::path const &target_path, std::filesystem::path const &base_path, input_t const &input)
     {
         std::filesystem::path filepath;
-        for (auto const &directory : std::filesystem::relative(std::filesystem::absolute(target_path), base_path))
+        for (auto const &directory : input.canonical(std::filesystem::absolute(target_path)).lexically_relative(input.canonical(base_path)))
         {
             if (directory == ".." || directory == ".")
                 continue;
@@ -121,6 +94,30 @@ namespace
         return count;
     }
 
+    /**
+     * @brief Get an optional boolean property of a GUI
+     * @param gui_node The YAML node of the GUI
+     * @param field The name of the property
+     * @return The value of the property (or `false` if it is not defined)
+     */
+    bool optional_boolean(YAML::Node const &gui_node, std::string const &field)
+    {
+        YAML::Node const value = gui_node[field];
+        if (!value.IsDefined())
+            return false;
+        if (value.IsScalar())
+        {
+            try
+            {
+                return value.as<bool>(false);
+            }
+            catch (std::exception const &e)
+            {
+            }
+        }
+        throw std::runtime_error("Unable to parse `" + field + "` since a boolean value is expected");
+    }
+
     /**
      * @brief Sanitize name for use in filesystem
      * @param name The name to sanitize
@@ -142,19 +139,33 @@ namespace
     }
 }
 
-generation_t::generation_t(std::filesystem::path const &configuration_file, std::filesystem::path const &output_directory)
+generation_t::generation_t(std::filesystem::path const &configuration_file, input_t const &input, output_t &output, cache_t const &cache)
     : m_guis({}),
+      m_budget({}),
       m_dependencies({}),
+      m_reserved_filenames({}),
       m_configuration_directory(std::filesystem::absolute(configuration_file.lexically_normal()).parent_path()),
-      m_output_directory(std::filesystem::absolute(output_directory.lexically_normal()))
+      m_input(input),
+      m_output(output),
+      m_cache(cache),
+      m_published({}),
+      m_staged({}),
+      m_published_mutex(),
+      m_structure_files({}),
+      m_structure_files_mutex(),
+      m_stylesheets({}),
+      m_module_bundles({})
 {
     std::vector<YAML::Node> gui_nodes = {};
+    YAML::Node budget_node;
     try
     {
-        for (auto const &document : YAML::LoadAllFromFile(configuration_file.string()))
+        for (auto const &document : YAML::LoadAll(m_input.read(std::filesystem::absolute(configuration_file))))
         {
             if (!document.IsDefined())
                 continue;
+            if (document.IsMap() && document["budget"].IsDefined())
+                budget_node.reset(document["budget"]);
             YAML::Node const guis = document["guis"];
             if (!guis.IsDefined() || !guis.IsSequence())
                 continue;
@@ -168,9 +179,33 @@ generation_t::generation_t(std::filesystem::path const &configuration_file, std:
     {
         throw std::runtime_error("Failed to load descriptive YAML file \"" + configuration_file.string() + "\"");
     }
+    m_budget = parse_budget(budget_node);
+
+    // Expand template GUIs into an instance per set of parameter values
+    std::vector<std::pair<YAML::Node, parameters_t>> expanded_gui_nodes = {};
     for (YAML::Node const &gui_node : gui_nodes)
     {
+        YAML::Node const parameters_node = gui_node["parameters"];
+        if (!parameters_node.IsDefined())
+        {
+            expanded_gui_nodes.emplace_back(gui_node, parameters_t());
+            continue;
+        }
+        if (!gui_node["name"].IsScalar() || gui_node["name"].Scalar().find("{{") == std::string::npos)
+            throw std::runtime_error("The `name` of a template GUI must use a parameter (such as \"Site {{site}}\") to keep each instance distinct");
+        for (auto const &parameters : template_instances(parameters_node))
+        {
+            YAML::Node instance = YAML::Clone(gui_node);
+            instance.remove("parameters");
+            substitute_parameters(instance, parameters);
+            expanded_gui_nodes.emplace_back(instance, parameters);
+        }
+    }
+    for (auto const &expanded_gui_node : expanded_gui_nodes)
+    {
+        YAML::Node const &gui_node = expanded_gui_node.first;
         gui_t current_gui_data = {};
+        current_gui_data.parameters = expanded_gui_node.second;
 
         // Check whether core configuration strings are present
         for (std::string const field : {"name", "config", "stylesheet"})
@@ -198,46 +233,75 @@ generation_t::generation_t(std::filesystem::path const &configuration_file, std:
 
         // Store configuration filepath of GUI
         current_gui_data.source_configuration_file = gui_node["config"].as<std::string>();
-        current_gui_data.source_configuration_file = convert_relative_path_to_absolute(current_gui_data.source_configuration_file, configuration_file).string();
-        if (current_gui_data.source_configuration_file.empty() || !std::filesystem::exists(current_gui_data.source_configuration_file))
+        current_gui_data.source_configuration_file = convert_relative_path_to_absolute(current_gui_data.source_configuration_file, configuration_file, m_input).string();
+        if (current_gui_data.source_configuration_file.empty() || !m_input.status(current_gui_data.source_configuration_file).exists)
             throw std::runtime_error("Unable to find a source config file of \"" + current_gui_data.source_configuration_file + "\"");
 
         // Store stylesheet filepath of GUI
-        current_gui_data.stylesheet_file = convert_relative_path_to_absolute(gui_node["stylesheet"].as<std::string>(), configuration_file);
+        current_gui_data.stylesheet_file = convert_relative_path_to_absolute(gui_node["stylesheet"].as<std::string>(), configuration_file, m_input);
         std::filesystem::path stylesheet_path = std::filesystem::absolute(current_gui_data.stylesheet_file);
-        if (!std::filesystem::exists(stylesheet_path.string()))
+        if (!m_input.status(stylesheet_path).exists)
             throw std::runtime_error("Unable to find the stylesheet \"" + current_gui_data.stylesheet_file + "\"");
-        current_gui_data.stylesheet_file = convert_absolute_path_to_relative(stylesheet_path, m_configuration_directory);
-        m_dependencies[std::filesystem::weakly_canonical(stylesheet_path)] = current_gui_data.stylesheet_file;
+        current_gui_data.stylesheet_file = convert_absolute_path_to_relative(stylesheet_path, m_configuration_directory, m_input);
+        std::filesystem::path const stylesheet_source = m_input.canonical(stylesheet_path.lexically_relative(m_configuration_directory));
+        m_dependencies[stylesheet_source] = current_gui_data.stylesheet_file;
+        current_gui_data.sources.emplace(stylesheet_source, "stylesheet");
+        current_gui_data.stylesheet_source = (m_configuration_directory / stylesheet_source).lexically_normal();
 
         // Set html filepath of GUI
         current_gui_data.html_file = sanitize_name(current_gui_data.name) + ".html";
-        if (std::filesystem::exists(m_output_directory / current_gui_data.html_file))
+        if (m_output.exists(current_gui_data.html_file))
             throw std::runtime_error("Unable to generate source for \"" + current_gui_data.html_file + "\" as a file already exists with that name");
 
-        // Store debug state of GUI
-        current_gui_data.debug = false;
-        YAML::Node const debug = gui_node["debug"];
-        if (debug.IsDefined())
+        // Store dependency pruning of GUI
+        current_gui_data.prune_dependencies = optional_boolean(gui_node, "prune_dependencies");
+        current_gui_data.reference_properties = {};
+        YAML::Node const reference_properties = gui_node["reference_properties"];
+        if (reference_properties.IsDefined())
         {
-            do
+            if (!reference_properties.IsSequence())
+                throw std::runtime_error("Unable to parse `reference_properties` since a list is expected");
+            for (YAML::Node const &property : reference_properties)
             {
-                if (debug.IsScalar())
-                {
-                    try
-                    {
-                        current_gui_data.debug = debug.as<bool>(false);
-                        continue;
-                    }
-                    catch (std::exception const &e)
-                    {
-                    }
-                }
-                throw std::runtime_error("Unable to parse `debug` since a boolean value is expected");
-            } while (false);
+                if (!property.IsScalar())
+                    throw std::runtime_error("Expected a string property name for a reference property in \"" + configuration_file.string() + "\"");
+                current_gui_data.reference_properties.push_back(property.as<std::string>());
+            }
         }
+
+        // Store payload budget of GUI
+        current_gui_data.budget = parse_budget(gui_node["budget"]);
+
+        // Store debug, prerender, critical stylesheet, and progressive rendering states of GUI
+        current_gui_data.debug = optional_boolean(gui_node, "debug");
+        current_gui_data.prerender = optional_boolean(gui_node, "prerender");
+        current_gui_data.critical_css = optional_boolean(gui_node, "critical_css");
+        current_gui_data.progressive = optional_boolean(gui_node, "progressive");
+        current_gui_data.bundle_modules = optional_boolean(gui_node, "bundle_modules");
+
+        // Store hot update interval of GUI (with a manifest next to its HTML file that the runtime polls)
+        current_gui_data.hot_update = 0;
+        YAML::Node const hot_update = gui_node["hot_update"];
+        if (hot_update.IsDefined())
+        {
+            try
+            {
+                if (hot_update.IsScalar())
+                    current_gui_data.hot_update = hot_update.as<std::uintmax_t>();
+            }
+            catch (YAML::BadConversion const &e)
+            {
+            }
+            if (current_gui_data.hot_update == 0)
+                throw std::runtime_error("Unable to parse `hot_update` since a positive number of seconds is expected");
+            current_gui_data.update_file = sanitize_name(current_gui_data.name) + ".update.json";
+            if (m_output.exists(current_gui_data.update_file))
+                throw std::runtime_error("Unable to generate source for \"" + current_gui_data.update_file + "\" as a file already exists with that name");
+        }
+
         // Check whether modules are listed
         current_gui_data.module_files = {};
+        current_gui_data.module_sources = {};
         YAML::Node const modules = gui_node["modules"];
         if (modules.IsDefined())
         {
@@ -254,17 +318,21 @@ generation_t::generation_t(std::filesystem::path const &configuration_file, std:
                     std::filesystem::path module_path;
                     try
                     {
-                        module_path = convert_relative_path_to_absolute(dep_node.as<std::string>(), configuration_file);
+                        module_path = convert_relative_path_to_absolute(dep_node.as<std::string>(), configuration_file, m_input);
                     }
                     catch (YAML::BadConversion const &e)
                     {
                         throw std::runtime_error("Expected a string path for a module in \"" + configuration_file.string() + "\"");
                     }
-                    if (std::filesystem::exists(module_path) && std::filesystem::is_regular_file(module_path))
+                    input_status_t const module_status = m_input.status(module_path);
+                    if (module_status.exists && !module_status.directory)
                     {
-                        std::filesystem::path module_path_relative = convert_absolute_path_to_relative(module_path, m_configuration_directory);
-                        m_dependencies[std::filesystem::weakly_canonical(module_path.lexically_relative(m_configuration_directory))] = module_path_relative;
+                        std::filesystem::path module_path_relative = convert_absolute_path_to_relative(module_path, m_configuration_directory, m_input);
+                        std::filesystem::path const module_source = m_input.canonical(module_path.lexically_relative(m_configuration_directory));
+                        m_dependencies[module_source] = module_path_relative;
+                        current_gui_data.sources.emplace(module_source, "modules");
                         current_gui_data.module_files.push_back(module_path_relative);
+                        current_gui_data.module_sources.push_back((m_configuration_directory / module_source).lexically_normal());
                     }
                     else
                         throw std::runtime_error("No module file exists at \"" + module_path.string() + "\"");
@@ -289,7 +357,7 @@ generation_t::generation_t(std::filesystem::path const &configuration_file, std:
                     std::string dependency_path;
                     try
                     {
-                        dependency_path = convert_relative_path_to_absolute(dep_node.as<std::string>(), configuration_file);
+                        dependency_path = convert_relative_path_to_absolute(dep_node.as<std::string>(), configuration_file, m_input);
                     }
                     catch (YAML::BadConversion const &e)
                     {
@@ -297,8 +365,12 @@ generation_t::generation_t(std::filesystem::path const &configuration_file, std:
                     }
                     try
                     {
-                        for (auto &&dependency : dependencies_t(dependency_path).paths())
-                            m_dependencies[std::filesystem::weakly_canonical(dependency.lexically_relative(m_configuration_directory))] = convert_absolute_path_to_relative(dependency, m_configuration_directory);
+                        for (auto &&dependency : dependencies_t(dependency_path, m_input).paths())
+                        {
+                            std::filesystem::path const dependency_source = m_input.canonical(dependency.lexically_relative(m_configuration_directory));
+                            m_dependencies[dependency_source] = convert_absolute_path_to_relative(dependency, m_configuration_directory, m_input);
+                            current_gui_data.sources.emplace(dependency_source, "dependencies");
+                        }
                     }
                     catch (std::exception const &e)
                     {
@@ -311,80 +383,321 @@ generation_t::generation_t(std::filesystem::path const &configuration_file, std:
         }
         m_guis.push_back(current_gui_data); // Add to the collection
     }
-    if (!std::filesystem::exists(m_output_directory))
-    {
-        if (!std::filesystem::create_directories(m_output_directory))
-            throw std::runtime_error("Failed to create output directory");
-    }
-    else if (!std::filesystem::is_directory(m_output_directory))
-        throw std::runtime_error("There is already a file located as the output directory location");
+    m_output.open();
 }
 
 generation_t::~generation_t()
 {
     m_guis.clear();
     m_dependencies.clear();
+    m_reserved_filenames.clear();
+    m_published.clear();
+    m_staged.clear();
+    m_structure_files.clear();
 }
 
-void generation_t::generate(generation_t::gui_t const &data, std::string const &guis_js_path, std::ostream const *debug_stream)
+std::vector<payload_t> generation_t::generate(std::vector<gui_t> const &guis, std::string const &guis_js_path, logger_t &logger, bool const service_worker, std::string const &telemetry_endpoint, std::vector<std::set<std::filesystem::path>> &references)
 {
-    std::string structure;
+    std::string names;
+    for (auto const &data : guis)
+        names += (names.empty() ? "" : ", ") + data.name;
+
+    std::vector<payload_t> payloads = {};
+    std::vector<std::string> prerendered(guis.size());
+    std::vector<std::string> structures(guis.size());
+    std::set<std::string> critical_classes = {};
     try
     {
-        // Generate structure
-        structure = structure_t(data.source_configuration_file, data.name, debug_stream).build(!data.debug);
+        // Generate structure (once for every GUI that shares it, with only template parameters substituted per GUI)
+        structure_t generated_structure(guis.front().source_configuration_file, names, logger, m_input, m_cache);
+        std::string const structure = generated_structure.build(!guis.front().debug);
+        std::map<std::string, std::size_t> const widget_types = generated_structure.widget_type_counts();
+        std::string const prerender = ([&]
+                                       { return std::any_of(guis.begin(), guis.end(), [](gui_t const &data)
+                                                            { return data.prerender; })
+                                                    ? generated_structure.prerender()
+                                                    : std::string(); })();
+        if (std::any_of(guis.begin(), guis.end(), [](gui_t const &data)
+                        { return data.critical_css; }))
+            critical_classes = generated_structure.top_level_types(2); // Widgets render their type as their class name
+        for (std::size_t i = 0; i < guis.size(); ++i)
+        {
+            gui_t const &data = guis[i];
+            payloads.emplace_back(data.name);
+            payloads.back().add_widgets(widget_types);
+            structures[i] = substitute_parameters(structure, data.parameters, escape_t::json);
+            if (data.prerender)
+                prerendered[i] = substitute_parameters(prerender, data.parameters, escape_t::html);
+            if (data.prune_dependencies)
+            {
+                // Resolve referenced assets to output paths (relative to the directory of the HTML file)
+                std::filesystem::path const html_directory = std::filesystem::path(data.html_file).parent_path();
+                for (std::string reference : generated_structure.references(data.reference_properties))
+                {
+                    reference = substitute_parameters(reference, data.parameters);
+                    if (reference.find("://") != std::string::npos || reference.rfind("//", 0) == 0 || reference.rfind("data:", 0) == 0 || reference.rfind("blob:", 0) == 0)
+                        continue; // Not a published file
+                    reference = reference.substr(0, reference.find_first_of("?#"));
+                    std::filesystem::path resolved;
+                    if (!reference.empty() && reference.front() == '/')
+                        resolved = std::filesystem::path(reference.substr(reference.find_first_not_of('/') == std::string::npos ? reference.size() : reference.find_first_not_of('/'))).lexically_normal();
+                    else
+                        resolved = (html_directory / reference).lexically_normal();
+                    if (!resolved.empty() && *resolved.begin() != "..")
+                        references[i].insert(resolved);
+                }
+                logger.info(data.name, "Found ", references[i].size(), " referenced asset(s)");
+            }
+        }
     }
     catch (std::exception const &e)
     {
-        throw std::runtime_error(data.name + ": " + e.what());
+        throw std::runtime_error(names + ": " + e.what());
     }
 
-    // Structure output filepath
-    std::string const structure_file = unique_filename("json");
-
-    std::string const relative_adjustment = [&]
+    std::set<std::string> group_structure_files = {};
+    for (std::size_t i = 0; i < guis.size(); ++i)
     {
-        std::string parent_path;
-        for (auto i = 0; i < name_as_path_depth(sanitize_name(data.name)); ++i)
-            parent_path += "../";
-        return parent_path;
-    }();
+        gui_t const &data = guis[i];
+        std::string const &structure = structures[i];
 
-    std::vector<std::string>
-        modules;
-    std::transform(data.module_files.begin(), data.module_files.end(), std::back_inserter(modules),
-                   [relative_adjustment](std::string const &module_file)
-                   {
-                       return relative_adjustment + module_file;
-                   });
+        // Structure output filepath (shared with any other GUIs whose structure is identical)
+        std::string structure_file;
+        bool new_structure_file = false;
+        {
+            std::lock_guard<std::mutex> lock(m_structure_files_mutex);
+            auto structure_entry = m_structure_files.find({hash_contents(structure), structure.size()});
+            if (structure_entry == m_structure_files.end())
+            {
+                structure_entry = m_structure_files.emplace(std::make_pair(hash_contents(structure), structure.size()), unique_filename("json")).first;
+                new_structure_file = true;
+            }
+            else if (group_structure_files.count(structure_entry->second) == 0)
+                logger.info(data.name, "Sharing the identical structure file \"", structure_entry->second, "\"");
+            structure_file = structure_entry->second;
+            group_structure_files.insert(structure_file);
+        }
+        if (new_structure_file)
+            publish(structure_file, structure);
 
-    // GUI JSON object
-    nlohmann::json gui_info = {
-        {"name", data.name},
-        {"structure", relative_adjustment + structure_file},
-        {"stylesheet", relative_adjustment + data.stylesheet_file},
-        {"modules", modules}};
+        std::string const relative_adjustment = [&]
+        {
+            std::string parent_path;
+            for (auto depth = 0; depth < name_as_path_depth(sanitize_name(data.name)); ++depth)
+                parent_path += "../";
+            return parent_path;
+        }();
+
+        std::vector<std::string>
+            modules;
+        std::vector<std::string> const module_files = (data.module_bundle_file.empty() ? data.module_files : std::vector<std::string>{data.module_bundle_file});
+        std::transform(module_files.begin(), module_files.end(), std::back_inserter(modules),
+                       [relative_adjustment](std::string const &module_file)
+                       {
+                           return relative_adjustment + module_file;
+                       });
+
+        // GUI JSON object
+        nlohmann::json gui_info = {
+            {"name", data.name},
+            {"structure", relative_adjustment + structure_file},
+            {"stylesheet", relative_adjustment + data.stylesheet_file},
+            {"modules", modules}};
+        if (service_worker)
+            gui_info["serviceWorker"] = "/" + service_worker_filename;
+        if (!telemetry_endpoint.empty())
+            gui_info["telemetry"] = telemetry_endpoint;
+        if (data.progressive)
+            gui_info["progressive"] = true;
+        if (data.hot_update > 0)
+        {
+            // Describe how the structure changed since the previous run (only possible when the cache persists it)
+            std::string const version = structure_version(structure);
+            nlohmann::json update = {
+                {"version", version},
+                {"structure", relative_adjustment + structure_file}};
+            std::string const cache_key = data.source_configuration_file + '\0' + data.name;
+            std::string previous;
+            if (m_cache.load_structure(cache_key, previous) && previous != structure)
+            {
+                try
+                {
+                    std::string const delta = structure_delta(previous, structure);
+                    std::string const delta_file = unique_filename("json");
+                    publish(delta_file, delta);
+                    update["delta"] = {
+                        {"base", structure_version(previous)},
+                        {"file", relative_adjustment + delta_file}};
+                    logger.info(data.name, "Generated a structure delta \"", delta_file, "\" (", delta.size(), " bytes)");
+                }
+                catch (std::exception const &e)
+                {
+                    logger.warning(data.name, "Unable to generate a structure delta (clients fetch the whole structure instead): ", e.what());
+                }
+            }
+            m_cache.store_structure(cache_key, structure);
+
+            // Staged rather than published, so that the service worker never serves a stale manifest
+            stage(data.update_file, update.dump());
+            gui_info["update"] = {
+                {"manifest", std::filesystem::path(data.update_file).filename().string()},
+                {"interval", data.hot_update},
+                {"version", version}};
+        }
 
-    // Generate HTML
-    std::string html = "<!DOCTYPE html><html><head><meta charset=\"UTF-8\"><meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\"><title>SSS</title><script type=\"text/javascript\">const gui=" + gui_info.dump() + ";</script><script type=\"text/javascript\" src=\"/" + guis_js_path + "\"></script></head><body><noscript>Browser not supported: JavaScript required!</noscript></body></html>";
+        // Generate HTML
+        std::string head_links;
+        if (data.critical_css)
+        {
+            // Style the top-level widgets from the HTML file itself, and fetch the whole stylesheet without blocking the first render
+            std::string critical = critical_stylesheet(m_stylesheets.at(data.stylesheet_source), critical_classes, std::filesystem::path(data.stylesheet_file).parent_path(), std::filesystem::path(data.html_file).parent_path());
+            for (std::size_t position = critical.find("</"); position != std::string::npos; position = critical.find("</", position + 3))
+                critical.replace(position, 2, "<\\/"); // Cannot close the style element early
+            head_links = "<style>" + critical + "</style><link rel=\"preload\" as=\"style\" href=\"" + relative_adjustment + data.stylesheet_file + "\">";
+            logger.info(data.name, "Inlined ", critical.size(), " bytes of critical stylesheet rules");
+        }
+        else if (data.prerender)
+            head_links = "<link rel=\"stylesheet\" href=\"" + relative_adjustment + data.stylesheet_file + "\">"; // Style pre-rendered widgets before JavaScript has loaded
+        if (!data.module_bundle_file.empty())
+            head_links += "<link rel=\"modulepreload\" href=\"" + relative_adjustment + data.module_bundle_file + "\">"; // Fetch the bundled modules whilst the runtime loads
+        std::string html = "<!DOCTYPE html><html><head><meta charset=\"UTF-8\"><meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\"><title>SSS</title>" + head_links + "<script type=\"text/javascript\">const gui=" + gui_info.dump() + ";</script><script type=\"text/javascript\" src=\"/" + guis_js_path + "\"></script></head><body>" + prerendered[i] + "<noscript>Browser not supported: JavaScript required!</noscript></body></html>";
+
+        // Write output files
+        publish(data.html_file, html);
+
+        payloads[i].add_file(data.html_file, "html", html.size());
+        payloads[i].add_file(structure_file, "structure", structure.size());
+        payloads[i].add_file(guis_js_path, "script", sss_guis_js_len);
+    }
+    return payloads;
+}
+
+void generation_t::stage(std::filesystem::path const &path, std::string const &contents)
+{
+    std::lock_guard<std::mutex> lock(m_published_mutex);
+    m_staged[path] = contents;
+}
+
+void generation_t::publish(std::filesystem::path const &path, std::string const &contents)
+{
+    std::uint64_t const hash = hash_contents(contents);
+    std::lock_guard<std::mutex> lock(m_published_mutex);
+    m_staged[path] = contents;
+    m_published[path] = hash;
+}
+
+void generation_t::prune_dependencies(std::vector<std::set<std::filesystem::path>> const &references, bool const flatten_dependency_references, logger_t &logger)
+{
+    if (std::none_of(m_guis.begin(), m_guis.end(), [](gui_t const &gui)
+                     { return gui.prune_dependencies; }))
+        return;
 
     /**
-     * @brief Write contents to a file
-     * @param filepath The location of the file to write to
-     * @param contents The contents of the file to be written
+     * @brief Check whether a path is (or is within) another path
+     * @param path The path to check
+     * @param parent The path that may contain `path`
+     * @return Whether `path` is (or is within) `parent`
      */
-    std::function<void(std::string, std::string)> write_file = [](std::string const &filepath, std::string const &content) -> void
+    auto const within = [](std::filesystem::path const &path, std::filesystem::path const &parent)
     {
-        std::filesystem::create_directories(std::filesystem::path(filepath).parent_path());
-        std::ofstream file(filepath);
-        if (!file)
-            throw std::runtime_error("Failed to open file for writing: " + filepath);
-        file << content;
+        auto const mismatch = std::mismatch(parent.begin(), parent.end(), path.begin(), path.end());
+        return (mismatch.first == parent.end());
     };
 
-    // Write output files
-    write_file((m_output_directory / data.html_file).string(), html);
-    write_file((m_output_directory / structure_file).string(), structure);
+    std::map<std::filesystem::path, std::filesystem::path> pruned = {};
+    std::vector<std::set<std::filesystem::path>> kept_sources(m_guis.size());
+    std::size_t removed_files = 0;
+    for (auto const &dependency : m_dependencies)
+    {
+        // Find the GUIs that use the dependency (including through a dependency within it)
+        bool prunable = true;
+        std::set<std::filesystem::path> referenced = {};
+        std::vector<std::filesystem::path> required = {}; // Sources within the dependency that must be kept entirely
+        std::vector<std::pair<std::size_t, std::filesystem::path>> user_sources = {};
+        for (std::size_t i = 0; i < m_guis.size(); ++i)
+        {
+            for (auto const &source : m_guis[i].sources)
+            {
+                if (!within(source.first, dependency.first))
+                    continue;
+                user_sources.emplace_back(i, source.first);
+                if (source.second != "dependencies" || !m_guis[i].prune_dependencies)
+                {
+                    required.push_back(source.first);
+                    prunable = (prunable && source.first != dependency.first);
+                }
+                referenced.insert(references[i].begin(), references[i].end());
+            }
+        }
+
+        /**
+         * @brief Keep the entire dependency
+         */
+        auto const keep = [&]()
+        {
+            pruned.insert(dependency);
+            for (auto const &user_source : user_sources)
+                kept_sources[user_source.first].insert(user_source.second);
+        };
+
+        if (!prunable || user_sources.empty())
+        {
+            keep();
+            continue;
+        }
+
+        std::filesystem::path const source = m_configuration_directory / dependency.first;
+        std::filesystem::path const destination = (flatten_dependency_references ? dependency.second.filename() : dependency.second);
+        if (!m_input.status(source).directory)
+        {
+            if (!required.empty() || referenced.count(destination.lexically_normal()))
+                keep();
+            else
+            {
+                removed_files++;
+                logger.debug("sss-guis", "Pruned unreferenced dependency \"", dependency.first.string(), "\"");
+            }
+        }
+        else if (flatten_dependency_references)
+            keep(); // Files within a directory cannot be kept individually without flattening them as well
+        else
+        {
+            // Keep only the referenced (or otherwise required) files within the directory
+            for (auto const &file : m_input.list(source))
+            {
+                std::filesystem::path const relative = file.lexically_normal().lexically_relative(source.lexically_normal());
+                bool const is_required = std::any_of(required.begin(), required.end(), [&](std::filesystem::path const &required_source)
+                                                     { return within(dependency.first / relative, required_source); });
+                if (!is_required && !referenced.count((destination / relative).lexically_normal()))
+                {
+                    removed_files++;
+                    logger.debug("sss-guis", "Pruned unreferenced dependency \"", (dependency.first / relative).string(), "\"");
+                    continue;
+                }
+                pruned[dependency.first / relative] = dependency.second / relative;
+                for (auto const &user_source : user_sources)
+                    kept_sources[user_source.first].insert(dependency.first / relative);
+            }
+        }
+    }
+    logger.info("sss-guis", "Pruned ", removed_files, " unreferenced dependency file", (removed_files != 1 ? "s" : ""));
+    m_dependencies = pruned;
+
+    // Only measure the dependencies that remain for GUIs that prune dependencies
+    for (std::size_t i = 0; i < m_guis.size(); ++i)
+    {
+        if (!m_guis[i].prune_dependencies)
+            continue;
+        for (auto source = m_guis[i].sources.begin(); source != m_guis[i].sources.end();)
+        {
+            if (source->second == "dependencies")
+                source = m_guis[i].sources.erase(source);
+            else
+                ++source;
+        }
+        for (auto const &source : kept_sources[i])
+            m_guis[i].sources.emplace(source, "dependencies");
+    }
 }
 
 std::filesystem::path generation_t::unique_filename(std::string const &extension)
@@ -401,80 +714,41 @@ std::filesystem::path generation_t::unique_filename(std::string const &extension
     while (true)
     {
         std::string filename = std::to_string(std::rand()) + '.' + extension;
-        bool unique = true;
-        // Check against dependencies
-        for (auto const &dependency : m_dependencies)
-        {
-            if (filename == dependency.second.filename())
-            {
-                unique = false;
-                break;
-            }
-        }
-        // Check against stylesheets
-        for (auto const &gui : m_guis)
-        {
-            if (filename == std::filesystem::path(gui.stylesheet_file).filename())
-            {
-                unique = false;
-                break;
-            }
-        }
+        // Check against dependencies, stylesheets, and previously generated filenames
+        bool const unique = m_reserved_filenames.insert(filename).second;
         if (unique)
             return filename;
     }
 }
 
-void generation_t::build_all(bool const disallow_conflicts, bool const flatten_dependency_references, std::ostream const *debug_stream)
+void generation_t::build_all(logger_t &logger, generation_options_t const &options, std::launch const group_launch)
 {
-    std::filesystem::copy_options copy_options = std::filesystem::copy_options::recursive;
-    if (disallow_conflicts)
-    {
-        copy_options |= std::filesystem::copy_options::overwrite_existing;
-        // Check if output dependencies will conflict with generated files
-        std::vector<std::filesystem::path> dependency_filenames = {};
-        for (auto const &dependency : m_dependencies)
-        {
-            std::filesystem::path const dependency_source = dependency.first;
-            std::filesystem::path const dependency_destination = dependency.second;
-            dependency_filenames.push_back(dependency.first.filename());
-            for (auto const &gui_data : m_guis)
+    dependency_index_t const dependency_index(m_dependencies);
+    if (options.disallow_conflicts)
+    {
+        // Check if output dependencies will conflict with generated files, existing files, or each other
+        std::vector<std::filesystem::path> generated_files = {};
+        for (auto const &gui_data : m_guis)
+        {
+            for (auto const &generated_file : {gui_data.html_file, gui_data.structure_file, gui_data.update_file})
             {
-                for (auto const &generated_file : {gui_data.html_file, gui_data.structure_file})
-                {
-                    if (flatten_dependency_references)
-                    {
-                        if (generated_file != dependency_destination.filename())
-                            continue;
-                    }
-                    else if (generated_file != dependency_destination)
-                        continue;
-                    throw std::runtime_error("A dependency of \"" + dependency_destination.string() + "\" will conflict with an automatically generated file");
-                }
+                if (!generated_file.empty())
+                    generated_files.push_back(generated_file);
             }
-            bool conflict = false;
-            if (flatten_dependency_references)
-                conflict = std::filesystem::exists(m_output_directory / dependency_destination.filename());
-            else
-                conflict = std::filesystem::exists(m_output_directory / dependency_destination);
-            if (conflict)
-                throw std::runtime_error("A dependency of \"" + dependency_source.string() + "\" will conflict with an already existing file");
         }
-        if (flatten_dependency_references)
+        if (options.service_worker)
+            generated_files.push_back(service_worker_filename);
+        std::vector<std::string> const conflicts = dependency_index.conflicts(generated_files, m_output.listing(), options.flatten_dependency_references);
+        if (!conflicts.empty())
         {
-            // Sort dependency filenames for faster finding...
-            std::sort(dependency_filenames.begin(), dependency_filenames.end(), [](std::filesystem::path const &a, std::filesystem::path const &b)
-                      { return a.filename().string() < b.filename().string(); });
-
-            // Check if output dependencies will conflict with each other when filenames are flattened
-            auto duplicate = std::adjacent_find(dependency_filenames.begin(), dependency_filenames.end(), [](std::filesystem::path const &a, std::filesystem::path const &b)
-                                                { return a.filename().string() == b.filename().string(); });
-            if (duplicate != dependency_filenames.end())
-                throw std::runtime_error("Conflicting filename of \"" + duplicate->filename().string() + "\" between flattened dependencies");
+            std::string message = conflicts.front();
+            for (auto conflict = std::next(conflicts.begin()); conflict != conflicts.end(); ++conflict)
+                message += "\n" + *conflict;
+            throw std::runtime_error(message);
         }
     }
 
-    if (flatten_dependency_references)
+    if (options.flatten_dependency_references)
     {
         // Flatten output stylesheet and module paths
         for (auto &&gui : m_guis)
@@ -485,53 +759,248 @@ void generation_t::build_all(bool const disallow_conflicts, bool const flatten_d
         }
     }
 
-    { // Remove sub dependencies
-        std::vector<std::filesystem::path> dependencies_keys = {};
-        for (auto const &dependency : m_dependencies)
-            dependencies_keys.push_back(dependency.first);
+    // Remove sub dependencies
+    for (auto const &descendant : dependency_index.descendants())
+        m_dependencies.erase(descendant);
+
+    // Reserve output filenames so that unique filenames can be checked in constant time
+    m_reserved_filenames.clear();
+    for (auto const &dependency : m_dependencies)
+        m_reserved_filenames.insert(dependency.second.filename().string());
+    for (auto const &gui : m_guis)
+        m_reserved_filenames.insert(std::filesystem::path(gui.stylesheet_file).filename().string());
+    m_reserved_filenames.insert(service_worker_filename);
+
+    // Build each stylesheet once (flattening the local stylesheets it imports, and minifying it), to be published in place of its source
+    m_stylesheets.clear();
+    for (auto const &gui : m_guis)
+    {
+        if (m_stylesheets.count(gui.stylesheet_source) > 0)
+            continue;
+        try
+        {
+            std::string const stylesheet = build_stylesheet(gui.stylesheet_source, m_input);
+            logger.info(gui.name, "Built stylesheet \"", gui.stylesheet_file, "\" (", m_input.status(gui.stylesheet_source).size, " bytes to ", stylesheet.size(), " bytes)");
+            m_stylesheets.emplace(gui.stylesheet_source, stylesheet);
+        }
+        catch (std::exception const &e)
+        {
+            throw std::runtime_error(gui.name + ": " + e.what());
+        }
+    }
 
-        std::vector<std::filesystem::path> dependenciesAllowed = remove_descendant_paths(dependencies_keys);
-        std::vector<std::filesystem::path> dependenciesDisallowed = {};
-        for (auto const &dependency : m_dependencies)
+    // Bundle the modules of GUIs that ask to into a single module each (named by its contents, so that GUIs with the same modules share it)
+    m_module_bundles.clear();
+    std::set<std::filesystem::path> bundled_sources = {};
+    for (auto &&gui : m_guis)
+    {
+        if (!gui.bundle_modules || gui.module_sources.empty())
+            continue;
+        std::string bundle;
+        try
+        {
+            bundle = bundle_module_files(gui.module_sources, m_input);
+        }
+        catch (std::exception const &e)
         {
-            if (std::find(dependenciesAllowed.begin(), dependenciesAllowed.end(), dependency.first) == dependenciesAllowed.end())
-                dependenciesDisallowed.push_back(dependency.first);
+            logger.warning(gui.name, "Loading modules separately: ", e.what());
+            continue;
+        }
+        gui.module_bundle_file = hash_to_string(hash_contents(bundle)) + ".js";
+        if (m_module_bundles.count(gui.module_bundle_file) == 0)
+        {
+            if (!m_reserved_filenames.insert(gui.module_bundle_file).second)
+                throw std::runtime_error(gui.name + ": Unable to generate source for \"" + gui.module_bundle_file + "\" as a dependency already uses that name");
+            publish(gui.module_bundle_file, bundle);
+            logger.info(gui.name, "Bundled ", gui.module_sources.size(), " module(s) into \"", gui.module_bundle_file, "\" (", bundle.size(), " bytes)");
+            m_module_bundles.emplace(gui.module_bundle_file, bundle);
+        }
+        for (auto source = gui.sources.begin(); source != gui.sources.end();)
+        {
+            if (source->second == "modules")
+            {
+                bundled_sources.insert(source->first);
+                source = gui.sources.erase(source);
+            }
+            else
+                ++source;
         }
-        for (auto const &disallowedDependency : dependenciesDisallowed)
-            m_dependencies.erase(disallowedDependency);
+    }
+    for (auto const &bundled_source : bundled_sources)
+    {
+        // Only publish the separate modules if another GUI still uses them
+        if (std::none_of(m_guis.begin(), m_guis.end(), [&bundled_source](gui_t const &gui)
+                         { return gui.sources.count(bundled_source) > 0; }))
+            m_dependencies.erase(bundled_source);
     }
 
     // Write GUI JavaScript file
     std::string guis_js_filename = unique_filename("js");
-    std::ofstream guis_js_stream(m_output_directory / guis_js_filename, std::ios::binary | std::ios::out);
-    if (!guis_js_stream.is_open())
-        throw std::runtime_error("Failed to create a file for writing output content to");
-    guis_js_stream.write(reinterpret_cast<const char *>(sss_guis_js), sss_guis_js_len);
-    guis_js_stream.close();
-
-    // Parallel processing loop
-    std::vector<std::future<void>> futures;
-    for (auto const &gui_data : m_guis)
-        futures.push_back(std::async(std::launch::async, [this, gui_data, guis_js_filename, debug_stream]()
-                                     { generate(gui_data, guis_js_filename, debug_stream); })); // Launch asynchronously
+    publish(guis_js_filename, std::string(reinterpret_cast<const char *>(sss_guis_js), sss_guis_js_len));
+
+    // Group GUIs that resolve to the same structure (same configuration file and debug state), so each structure is only built once
+    std::map<std::pair<std::string, bool>, std::vector<std::size_t>> structure_groups = {};
+    for (std::size_t i = 0; i < m_guis.size(); ++i)
+        structure_groups[{m_guis[i].source_configuration_file, m_guis[i].debug}].push_back(i);
+
+    // Parallel processing loop (deferred groups are instead generated while waiting below)
+    std::vector<std::future<std::vector<payload_t>>> futures;
+    std::vector<std::vector<std::set<std::filesystem::path>>> group_references = {};
+    group_references.reserve(structure_groups.size());
+    for (auto const &structure_group : structure_groups)
+    {
+        std::vector<gui_t> group_guis = {};
+        for (auto const i : structure_group.second)
+            group_guis.push_back(m_guis[i]);
+        group_references.emplace_back(group_guis.size());
+        futures.push_back(std::async(group_launch, [this, group_guis, guis_js_filename, &logger, &options, &references = group_references.back()]()
+                                     { return generate(group_guis, guis_js_filename, logger, options.service_worker, options.telemetry_endpoint, references); })); // Launch asynchronously (unless deferred)
+    }
 
     // Wait for all threads to complete
-    for (auto &future : futures)
-        future.get(); // Blocks until the task completes and propagates exceptions
+    std::map<std::size_t, payload_t> gui_payloads = {};
+    std::vector<std::set<std::filesystem::path>> references(m_guis.size());
+    auto future = futures.begin();
+    auto group_reference = group_references.begin();
+    for (auto const &structure_group : structure_groups)
+    {
+        std::vector<payload_t> group_payloads = (future++)->get(); // Blocks until the task completes and propagates exceptions
+        for (std::size_t j = 0; j < structure_group.second.size(); ++j)
+        {
+            gui_payloads.emplace(structure_group.second[j], group_payloads[j]);
+            references[structure_group.second[j]] = (*group_reference)[j];
+        }
+        ++group_reference;
+    }
+    std::vector<payload_t> payloads = {};
+    for (auto const &gui_payload : gui_payloads)
+        payloads.push_back(gui_payload.second);
+
+    prune_dependencies(references, options.flatten_dependency_references, logger);
+
+    /**
+     * @brief Read a source file as it is published (built stylesheets are published in place of their sources)
+     * @param file The absolute path of the source file
+     * @return The published contents of the file
+     */
+    auto const published_contents = [this](std::filesystem::path const &file)
+    {
+        auto const stylesheet = m_stylesheets.find(file.lexically_normal());
+        return (stylesheet != m_stylesheets.end() ? stylesheet->second : m_input.read(file));
+    };
+
+    /**
+     * @brief Measure a source file as it is published
+     * @param file The absolute path of the source file
+     * @return The published size of the file
+     */
+    auto const published_size = [this](std::filesystem::path const &file)
+    {
+        auto const stylesheet = m_stylesheets.find(file.lexically_normal());
+        return (stylesheet != m_stylesheets.end() ? static_cast<std::uintmax_t>(stylesheet->second.size()) : m_input.status(file).size);
+    };
+
+    // Measure the sources of each GUI, then check every payload against its budget (before anything is written to the output)
+    payload_t total_payload("All GUIs");
+    std::vector<std::string> exceeded = {};
+    for (std::size_t i = 0; i < m_guis.size(); ++i)
+    {
+        for (auto const &source : m_guis[i].sources)
+        {
+            std::filesystem::path const source_path = (m_configuration_directory / source.first).lexically_normal();
+            if (!m_input.status(source_path).directory)
+                payloads[i].add_file(source_path.lexically_relative(m_configuration_directory), source.second, published_size(source_path));
+            else
+            {
+                for (auto const &file : m_input.list(source_path))
+                    payloads[i].add_file(file.lexically_normal().lexically_relative(m_configuration_directory), source.second, published_size(file));
+            }
+        }
+        if (!m_guis[i].module_bundle_file.empty())
+            payloads[i].add_file(m_guis[i].module_bundle_file, "modules", m_module_bundles.at(m_guis[i].module_bundle_file).size());
+        total_payload.merge(payloads[i]);
+        for (auto const &message : payloads[i].exceeded(m_guis[i].budget))
+            exceeded.push_back(message);
+    }
+    for (auto const &message : total_payload.exceeded(m_budget))
+        exceeded.push_back(message);
+    if (!options.report_file.empty())
+    {
+        nlohmann::json report = {{"guis", nlohmann::json::array()}, {"total", total_payload.report()}, {"exceeded", exceeded}};
+        for (auto const &payload : payloads)
+            report["guis"].push_back(payload.report());
+        std::ofstream report_stream(options.report_file);
+        if (!(report_stream << report.dump(4) << '\n'))
+            throw std::runtime_error("Unable to write the payload report \"" + options.report_file.string() + "\"");
+        logger.info("sss-guis", "Wrote payload report \"", options.report_file.string(), "\"");
+    }
+    if (!exceeded.empty())
+    {
+        std::string message = exceeded.front();
+        for (auto budget = std::next(exceeded.begin()); budget != exceeded.end(); ++budget)
+            message += "\n" + *budget;
+        throw std::runtime_error(message);
+    }
+
+    // Every budget is met, so write the generated files
+    for (auto const &staged : m_staged)
+        m_output.write(staged.first, staged.second);
+    m_staged.clear();
 
     // Copy dependencies
     for (auto const &dependency : m_dependencies)
     {
         std::filesystem::path const dependency_source = dependency.first;
         std::filesystem::path const dependency_destination = dependency.second;
-
-        if (flatten_dependency_references)
-            std::filesystem::copy((m_configuration_directory / dependency_source), (m_output_directory / dependency_destination.filename()), copy_options);
+        logger.debug("sss-guis", "Copying dependency \"", dependency_source.string(), "\"");
+
+        std::filesystem::path const source = m_configuration_directory / dependency_source;
+        std::filesystem::path const destination = options.flatten_dependency_references ? dependency_destination.filename() : dependency_destination;
+        bool const contains_stylesheet = std::any_of(m_stylesheets.begin(), m_stylesheets.end(), [&source](auto const &stylesheet)
+                                                     {
+                                                         std::filesystem::path const relative = stylesheet.first.lexically_relative(source.lexically_normal());
+                                                         return (!relative.empty() && *relative.begin() != ".."); });
+        if (m_input.native() && !contains_stylesheet)
+            m_output.copy(source, destination, options.disallow_conflicts); // Only replaces existing files once conflicting names were rejected above
+        else if (m_input.status(source).directory)
+        {
+            for (auto const &file : m_input.list(source))
+                m_output.write(destination / file.lexically_relative(source.lexically_normal()), published_contents(file));
+        }
         else
+            m_output.write(destination, published_contents(source));
+
+        if (options.service_worker)
+        {
+            // Record the hash of each copied file for the precache manifest
+            if (m_input.status(source).directory)
+            {
+                for (auto const &file : m_input.list(source))
+                    m_published[destination / file.lexically_relative(source.lexically_normal())] = hash_contents(published_contents(file));
+            }
+            else
+                m_published[destination] = hash_contents(published_contents(source));
+        }
+    }
+
+    if (options.service_worker)
+    {
+        // Write the service worker with its precache manifest (any changed file changes the service worker, which triggers an update)
+        nlohmann::json files = nlohmann::json::object();
+        std::uint64_t version = hash_contents("");
+        for (auto const &published : m_published)
         {
-            std::filesystem::create_directories(m_output_directory / dependency_destination.parent_path());
-            std::filesystem::copy((m_configuration_directory / dependency_source), (m_output_directory / dependency_destination), copy_options);
+            std::string const path = published.first.generic_string();
+            std::string const hash = hash_to_string(published.second);
+            files[path] = hash;
+            version = hash_contents(path + '\0' + hash + '\0', version);
         }
+        nlohmann::json const manifest = {
+            {"version", hash_to_string(version)},
+            {"files", files}};
+        logger.info("sss-guis", "Writing service worker precaching ", m_published.size(), " file(s)");
+        m_output.write(service_worker_filename, "const manifest=" + manifest.dump() + ";" + std::string(reinterpret_cast<const char *>(sss_guis_service_worker), sss_guis_service_worker_len));
     }
+    m_output.close();
     return;
 }
@@ -1,8 +1,20 @@
 #pragma once
 
+#include "cache.hpp"
+#include "input.hpp"
+#include "logging.hpp"
+#include "output.hpp"
+#include "payload.hpp"
+#include "templates.hpp"
+
 #include <filesystem>
+#include <future>
+#include <cstdint>
 #include <map>
+#include <mutex>
+#include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace sss::guis
@@ -23,6 +35,26 @@ namespace sss::guis
              * @brief Whether the GUI should be generated with debug mode
              */
             bool debug;
+            /**
+             * @brief Whether the static widgets of the GUI should be rendered into its HTML file
+             */
+            bool prerender;
+            /**
+             * @brief Whether media widgets should render placeholders that their media fills in once loaded, rather than delaying the first render of the GUI
+             */
+            bool progressive;
+            /**
+             * @brief Whether the stylesheet rules that the top-level widgets need should be inlined into the HTML file (with the stylesheet preloaded rather than blocking the first render)
+             */
+            bool critical_css;
+            /**
+             * @brief Whether dependencies that no reachable widget references should not be copied
+             */
+            bool prune_dependencies;
+            /**
+             * @brief Names of properties (of any widget) whose values are asset paths, used when pruning dependencies
+             */
+            std::vector<std::string> reference_properties;
             /**
              * @brief The initial configuration file for the GUI
              */
@@ -31,6 +63,10 @@ namespace sss::guis
              * @brief Path of stylesheet
              */
             std::string stylesheet_file;
+            /**
+             * @brief Absolute path of the source stylesheet
+             */
+            std::filesystem::path stylesheet_source;
             /**
              * @brief Output file path of HTML file
              */
@@ -39,34 +75,133 @@ namespace sss::guis
              * @brief Output file path of generated structure
              */
             std::string structure_file;
+            /**
+             * @brief Output file path of the hot update manifest (empty if hot updates are disabled)
+             */
+            std::string update_file;
+            /**
+             * @brief Seconds between checks for a new version of the structure (0 if hot updates are disabled)
+             */
+            std::uintmax_t hot_update;
             /**
              * @brief Paths of modules
              */
             std::vector<std::string> module_files;
+            /**
+             * @brief Absolute paths of the source modules (in the order they load)
+             */
+            std::vector<std::filesystem::path> module_sources;
+            /**
+             * @brief Whether the modules should be bundled into a single module
+             */
+            bool bundle_modules;
+            /**
+             * @brief Output file path of the bundled modules (empty if the modules are not bundled)
+             */
+            std::string module_bundle_file;
+            /**
+             * @brief Dependency sources (stylesheet, modules, and dependencies) used by the GUI and their payload category
+             */
+            std::map<std::filesystem::path, std::string> sources;
+            /**
+             * @brief Maximum bytes of the payload of the GUI
+             */
+            budget_t budget;
+            /**
+             * @brief Values of the template parameters that the GUI was expanded with (substituted for `{{name}}` within its widgets)
+             */
+            parameters_t parameters;
         };
         /**
          * @brief Collection of all GUI's data
          */
         std::vector<gui_t> m_guis;
+        /**
+         * @brief Maximum bytes of the payload of all GUIs
+         */
+        budget_t m_budget;
         /**
          * @brief Collection of all dependencies
          */
         std::map<std::filesystem::path, std::filesystem::path> m_dependencies;
+        /**
+         * @brief Output filenames that generated files must not use
+         */
+        std::unordered_set<std::string> m_reserved_filenames;
         /**
          * @brief The output directory for all generated file
          */
         std::filesystem::path const m_configuration_directory;
         /**
-         * @brief The source configuration file to find structures in
+         * @brief The input to read all source files from
+         */
+        input_t const &m_input;
+        /**
+         * @brief The output to write all generated file to
+         */
+        output_t &m_output;
+        /**
+         * @brief Cache of parsed configuration files (may be shared with other generations)
+         */
+        cache_t const &m_cache;
+        /**
+         * @brief Content hashes of all published files (keyed by output path)
+         */
+        std::map<std::filesystem::path, std::uint64_t> m_published;
+        /**
+         * @brief Generated files waiting to be written to the output (keyed by output path), so that nothing is written until every budget is met
+         */
+        std::map<std::filesystem::path, std::string> m_staged;
+        /**
+         * @brief Guards the published content hashes and staged files (GUIs are generated in parallel)
          */
-        std::filesystem::path const m_output_directory;
+        std::mutex m_published_mutex;
         /**
-         * @brief Generates a GUI
-         * @param gui The GUI to generate
+         * @brief Output files of generated structures (keyed by the hash and size of their contents)
+         */
+        std::map<std::pair<std::uint64_t, std::size_t>, std::string> m_structure_files;
+        /**
+         * @brief Guards the output files of generated structures (structures are generated in parallel)
+         */
+        std::mutex m_structure_files_mutex;
+        /**
+         * @brief Built stylesheets (flattened and minified), which are published in place of their sources (keyed by the absolute path of their source)
+         */
+        std::map<std::filesystem::path, std::string> m_stylesheets;
+        /**
+         * @brief Bundled modules (keyed by output file path, which is named by the hash of the bundle so GUIs with the same modules share it)
+         */
+        std::map<std::string, std::string> m_module_bundles;
+        /**
+         * @brief Generates GUIs that share a structure, which is built once and written to a single structure file
+         * @param guis The GUIs to generate (which all have the same source configuration file and debug state)
          * @param guis_js_path The path to the main JavaScript file
-         * @param debug_stream A `std::ofstream` to write debug outputs to
+         * @param logger The logger to write debug outputs to
+         * @param service_worker Whether the GUIs should register the service worker
+         * @param telemetry_endpoint The URL that the GUIs send their recorded runtime timings to once loaded (if empty then timings are not sent)
+         * @param references Output paths of the assets referenced by each GUI's widgets (only collected when pruning dependencies, in the order of `guis`)
+         * @return The payload of the generated files of each GUI (in the order of `guis`)
+         */
+        std::vector<payload_t> generate(std::vector<gui_t> const &guis, std::string const &guis_js_path, logger_t &logger, bool const service_worker, std::string const &telemetry_endpoint, std::vector<std::set<std::filesystem::path>> &references);
+        /**
+         * @brief Remove dependencies (or files within dependency directories) that are only used by GUIs which prune dependencies, and that none of their widgets reference
+         * @param references Output paths of the assets referenced by each GUI's widgets
+         * @param flatten_dependency_references Whether dependency output files are flattened to just their filename
+         * @param logger The logger to write debug outputs to
+         */
+        void prune_dependencies(std::vector<std::set<std::filesystem::path>> const &references, bool const flatten_dependency_references, logger_t &logger);
+        /**
+         * @brief Stage a generated file to be written to the output (once every budget is met)
+         * @param path The output path of the file
+         * @param contents The contents of the file
+         */
+        void stage(std::filesystem::path const &path, std::string const &contents);
+        /**
+         * @brief Stage a generated file to be written to the output and record the hash of its contents
+         * @param path The output path of the file
+         * @param contents The contents of the file
          */
-        void generate(gui_t const &gui, std::string const &guis_js_path, std::ostream const *debug_stream = nullptr);
+        void publish(std::filesystem::path const &path, std::string const &contents);
         /**
          * @brief Generate a unique filename against the dependencies with a specified extension
          * @param extension The extension to use for the unique file
@@ -78,19 +213,21 @@ namespace sss::guis
         /**
          * @brief Construct a GUI generator
          * @param configuration_file The source configuration file to find structures in
-         * @param output_directory The output directory for all generated file
+         * @param input The input to read all source files from
+         * @param output The output to write all generated file to
+         * @param cache The cache of parsed configuration files (must outlive the generator, and read from `input`)
          */
-        generation_t(std::filesystem::path const &configuration_file, std::filesystem::path const &output_directory);
+        generation_t(std::filesystem::path const &configuration_file, input_t const &input, output_t &output, cache_t const &cache);
         /**
          * @brief Deconstructor
          */
         ~generation_t();
         /**
          * @brief Build all GUIs and manage dependencies
-         * @param disallow_conflicts Do not allow dependencies or generated file to have conflicting output file name
-         * @param flatten_dependency_references Whether to flatten dependency output files to just their filename (no directory hierarchy)
-         * @param debug_stream A `std::ofstream` to write debug outputs to
+         * @param logger The logger to write debug outputs to
+         * @param options How to generate the GUIs (its debug stream and log level are already applied to `logger`)
+         * @param group_launch How each structure group is generated (`std::launch::deferred` runs them one after another on the calling thread, such as when it is already one of a pool of workers)
          */
-        void build_all(bool const disallow_conflicts = true, bool const flatten_dependency_references = false, std::ostream const *debug_stream = nullptr);
+        void build_all(logger_t &logger, generation_options_t const &options, std::launch const group_launch = std::launch::async);
     };
 }
@@ -1,11 +1,33 @@
 #include "guis.hpp"
 #include "generation.hpp"
+#include "logging.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
 
 using namespace sss::guis;
 
-guis_t::guis_t(std::filesystem::path const &configuration_file, std::filesystem::path const &m_output_directory)
+guis_t::guis_t(std::filesystem::path const &configuration_file, std::filesystem::path const &output_directory, std::filesystem::path const &cache_directory, input_t const *input)
+    : m_configuration_directory(configuration_file),
+      m_owned_output(std::make_unique<directory_output_t>(output_directory)),
+      m_output(*m_owned_output),
+      m_owned_input(input == nullptr ? std::make_unique<filesystem_input_t>() : nullptr),
+      m_input(input == nullptr ? *m_owned_input : *input),
+      m_cache_directory(cache_directory)
+{
+}
+
+guis_t::guis_t(std::filesystem::path const &configuration_file, output_t &output, std::filesystem::path const &cache_directory, input_t const *input)
     : m_configuration_directory(configuration_file),
-      m_output_directory(m_output_directory)
+      m_owned_output(nullptr),
+      m_output(output),
+      m_owned_input(input == nullptr ? std::make_unique<filesystem_input_t>() : nullptr),
+      m_input(input == nullptr ? *m_owned_input : *input),
+      m_cache_directory(cache_directory)
 {
 }
 
@@ -13,7 +35,62 @@ guis_t::~guis_t()
 {
 }
 
-void guis_t::generate(bool const disallow_conflicts, bool const flatten_dependency_references, std::ostream const *debug_stream)
+void guis_t::generate(generation_options_t const &options)
 {
-    generation_t(m_configuration_directory, m_output_directory).build_all(disallow_conflicts, flatten_dependency_references, debug_stream);
+    logger_t logger(options.debug_stream, options.log_level);
+    caching_input_t const input(m_input);
+    cache_t const cache(m_cache_directory, input);
+    generation_t(m_configuration_directory, input, m_output, cache).build_all(logger, options);
+}
+
+void guis_t::generate_batch(std::vector<batch_entry_t> const &entries, std::filesystem::path const &cache_directory, input_t const *input, generation_options_t const &options)
+{
+    if (entries.empty())
+        return;
+    std::unique_ptr<input_t> const owned_input(input == nullptr ? std::make_unique<filesystem_input_t>() : nullptr);
+    caching_input_t const shared_input(input == nullptr ? *owned_input : *input); // Also shares metadata and directory listings between entries
+    logger_t logger(options.debug_stream, options.log_level);
+    cache_t const cache(cache_directory, shared_input);
+
+    // A fixed set of workers take entries in order, so a large batch does not oversubscribe the machine
+    std::atomic<std::size_t> next_entry(0);
+    std::vector<std::string> errors(entries.size());
+    std::size_t const worker_count = std::min<std::size_t>(entries.size(), std::max(1u, std::thread::hardware_concurrency()));
+    auto const work = [&]()
+    {
+        for (std::size_t index = next_entry++; index < entries.size(); index = next_entry++)
+        {
+            batch_entry_t const &entry = entries[index];
+            try
+            {
+                directory_output_t output(entry.output_directory);
+                generation_options_t entry_options = options;
+                entry_options.report_file = entry.report_file;
+                // Structure groups run on this worker (deferred), so the batch never uses more threads than the pool
+                generation_t(entry.configuration_file, shared_input, output, cache).build_all(logger, entry_options, std::launch::deferred);
+            }
+            catch (std::exception const &e)
+            {
+                errors[index] = "\"" + entry.configuration_file.string() + "\": " + e.what();
+            }
+        }
+    };
+    std::vector<std::future<void>> workers = {};
+    for (std::size_t i = 0; i < worker_count; i++)
+        workers.push_back(std::async(std::launch::async, work));
+    for (auto &worker : workers)
+        worker.get();
+
+    // Report every failed entry together, in the order they were given
+    std::string message;
+    for (auto const &error : errors)
+    {
+        if (error.empty())
+            continue;
+        if (!message.empty())
+            message += "\n";
+        message += error;
+    }
+    if (!message.empty())
+        throw std::runtime_error(message);
 }
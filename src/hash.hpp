@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace sss::guis
+{
+    /**
+     * @brief Hash contents with 64-bit FNV-1a (not cryptographic; used to detect changed contents)
+     * @param contents The contents to hash
+     * @param hash The hash to continue from (allows hashing in parts)
+     * @return Hash of the contents
+     */
+    inline std::uint64_t hash_contents(std::string_view const contents, std::uint64_t hash = 14695981039346656037ULL)
+    {
+        for (unsigned char const character : contents)
+        {
+            hash ^= character;
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Represent a hash as a fixed width hexadecimal string
+     * @param hash The hash to represent
+     * @return Hexadecimal string
+     */
+    inline std::string hash_to_string(std::uint64_t const hash)
+    {
+        std::ostringstream stream;
+        stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return stream.str();
+    }
+}
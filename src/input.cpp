@@ -0,0 +1,202 @@
+#include "input.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+using namespace sss::guis;
+
+namespace
+{
+    /**
+     * @brief Checks if a filepath is within a directory
+     * @param directory Directory filepath
+     * @param path Filepath
+     * @returns If the path is within the directory
+     */
+    bool is_within(std::filesystem::path const &directory, std::filesystem::path const &path)
+    {
+        auto const [directory_iterator, path_iterator] = std::mismatch(directory.begin(), directory.end(), path.begin(), path.end());
+        return (directory_iterator == directory.end() && path_iterator != path.end());
+    }
+
+    /**
+     * @brief Get the key that an in-memory file is stored under
+     * @param path The path of the file
+     * @returns Absolute, normalized path (without a trailing separator)
+     */
+    std::filesystem::path memory_key(std::filesystem::path const &path)
+    {
+        std::filesystem::path key = std::filesystem::absolute(path).lexically_normal();
+        if (!key.has_filename() && key.has_relative_path())
+            key = key.parent_path(); // Remove trailing separator
+        return key;
+    }
+}
+
+filesystem_input_t::filesystem_input_t()
+{
+}
+
+input_status_t filesystem_input_t::status(std::filesystem::path const &path) const
+{
+    input_status_t status = {false, false, 0, 0};
+    std::error_code error;
+    std::filesystem::file_status const file_status = std::filesystem::status(path, error);
+    if (error || !std::filesystem::exists(file_status))
+        return status;
+    status.exists = true;
+    status.directory = std::filesystem::is_directory(file_status);
+    if (std::filesystem::is_regular_file(file_status))
+    {
+        status.size = std::filesystem::file_size(path);
+        status.modification_time = std::filesystem::last_write_time(path).time_since_epoch().count();
+    }
+    return status;
+}
+
+std::string filesystem_input_t::read(std::filesystem::path const &path) const
+{
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream)
+        throw std::runtime_error("Failed to open file for reading: " + path.string());
+    return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+std::vector<std::filesystem::path> filesystem_input_t::list(std::filesystem::path const &directory) const
+{
+    std::vector<std::filesystem::path> files = {};
+    for (auto const &entry : std::filesystem::recursive_directory_iterator(directory))
+    {
+        if (entry.is_regular_file())
+            files.push_back(entry.path());
+    }
+    return files;
+}
+
+std::filesystem::path filesystem_input_t::canonical(std::filesystem::path const &path) const
+{
+    return std::filesystem::weakly_canonical(path);
+}
+
+bool filesystem_input_t::native() const
+{
+    return true;
+}
+
+memory_input_t::memory_input_t()
+    : m_files({})
+{
+}
+
+void memory_input_t::add(std::filesystem::path const &path, std::string const &contents)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_files[memory_key(path)] = contents;
+}
+
+input_status_t memory_input_t::status(std::filesystem::path const &path) const
+{
+    std::filesystem::path const key = memory_key(path);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const file = m_files.lower_bound(key);
+    if (file == m_files.end())
+        return {false, false, 0, 0};
+    if (file->first == key)
+        return {true, false, file->second.size(), 0};
+    // Directories exist implicitly when a file is within them
+    if (is_within(key, file->first))
+        return {true, true, 0, 0};
+    return {false, false, 0, 0};
+}
+
+std::string memory_input_t::read(std::filesystem::path const &path) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const file = m_files.find(memory_key(path));
+    if (file == m_files.end())
+        throw std::runtime_error("Failed to open file for reading: " + path.string());
+    return file->second;
+}
+
+std::vector<std::filesystem::path> memory_input_t::list(std::filesystem::path const &directory) const
+{
+    std::filesystem::path const key = memory_key(directory);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::filesystem::path> files = {};
+    for (auto file = m_files.lower_bound(key); file != m_files.end() && is_within(key, file->first); ++file)
+        files.push_back(file->first);
+    return files;
+}
+
+std::filesystem::path memory_input_t::canonical(std::filesystem::path const &path) const
+{
+    return path.lexically_normal();
+}
+
+bool memory_input_t::native() const
+{
+    return false;
+}
+
+caching_input_t::caching_input_t(input_t const &input)
+    : m_input(input),
+      m_mutex(),
+      m_statuses({}),
+      m_canonical_paths({}),
+      m_listings({})
+{
+}
+
+input_status_t caching_input_t::status(std::filesystem::path const &path) const
+{
+    std::filesystem::path const key = path.lexically_normal();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto const cached = m_statuses.find(key);
+        if (cached != m_statuses.end())
+            return cached->second;
+    }
+    // Not held whilst querying, so that slow queries (such as on network filesystems) run in parallel
+    input_status_t const status = m_input.status(path);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statuses.emplace(key, status).first->second;
+}
+
+std::string caching_input_t::read(std::filesystem::path const &path) const
+{
+    return m_input.read(path);
+}
+
+std::vector<std::filesystem::path> caching_input_t::list(std::filesystem::path const &directory) const
+{
+    std::filesystem::path const key = directory.lexically_normal();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto const cached = m_listings.find(key);
+        if (cached != m_listings.end())
+            return cached->second;
+    }
+    std::vector<std::filesystem::path> const files = m_input.list(directory);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_listings.emplace(key, files).first->second;
+}
+
+std::filesystem::path caching_input_t::canonical(std::filesystem::path const &path) const
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto const cached = m_canonical_paths.find(path);
+        if (cached != m_canonical_paths.end())
+            return cached->second;
+    }
+    std::filesystem::path const canonical_path = m_input.canonical(path);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_canonical_paths.emplace(path, canonical_path).first->second;
+}
+
+bool caching_input_t::native() const
+{
+    return m_input.native();
+}
@@ -0,0 +1,127 @@
+#include "logging.hpp"
+
+#include <atomic>
+#include <chrono>
+
+using namespace sss::guis;
+
+namespace
+{
+    /**
+     * @brief How often buffered messages are written out
+     */
+    constexpr std::chrono::milliseconds drain_interval(50);
+
+    /**
+     * @brief Size a thread's buffer can reach before an early drain is requested
+     */
+    constexpr std::size_t drain_threshold = 64 * 1024;
+
+    /**
+     * @brief Source of unique logger identifiers
+     */
+    std::atomic<std::uint64_t> logger_identifiers(1);
+}
+
+logger_t::logger_t(std::ostream const *stream, log_level_t const level)
+    : m_stream(const_cast<std::ostream *>(stream)),
+      m_level(level),
+      m_identifier(logger_identifiers++),
+      m_buffers(),
+      m_stopping(false)
+{
+    if (m_stream == nullptr || m_level == log_level_t::none)
+        return;
+    m_drain_thread = std::thread([this]()
+                                 {
+                                     std::unique_lock<std::mutex> lock(m_drain_mutex);
+                                     while (!m_stopping)
+                                     {
+                                         m_drain_condition.wait_for(lock, drain_interval);
+                                         lock.unlock();
+                                         drain();
+                                         lock.lock();
+                                     } });
+}
+
+logger_t::~logger_t()
+{
+    if (m_drain_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_drain_mutex);
+            m_stopping = true;
+        }
+        m_drain_condition.notify_one();
+        m_drain_thread.join();
+    }
+    drain();
+    m_buffers.clear();
+}
+
+bool logger_t::enabled(log_level_t const level) const
+{
+    return (m_stream != nullptr && level != log_level_t::none && static_cast<int>(level) <= static_cast<int>(m_level));
+}
+
+logger_t::buffer_t &logger_t::thread_buffer()
+{
+    thread_local std::uint64_t cached_identifier = 0;
+    thread_local buffer_t *cached_buffer = nullptr;
+    if (cached_identifier == m_identifier)
+        return *cached_buffer;
+
+    std::thread::id const owner = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(m_buffers_mutex);
+    buffer_t *buffer = nullptr;
+    for (auto const &existing_buffer : m_buffers)
+    {
+        if (existing_buffer->owner == owner)
+        {
+            buffer = existing_buffer.get();
+            break;
+        }
+    }
+    if (buffer == nullptr)
+    {
+        m_buffers.push_back(std::make_unique<buffer_t>());
+        buffer = m_buffers.back().get();
+        buffer->owner = owner;
+    }
+    cached_identifier = m_identifier;
+    cached_buffer = buffer;
+    return *buffer;
+}
+
+void logger_t::write(std::string const &message)
+{
+    buffer_t &buffer = thread_buffer();
+    bool full = false;
+    {
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        buffer.contents += message;
+        full = (buffer.contents.size() >= drain_threshold);
+    }
+    if (full)
+        m_drain_condition.notify_one();
+}
+
+void logger_t::drain()
+{
+    if (m_stream == nullptr)
+        return;
+    std::string pending;
+    {
+        std::lock_guard<std::mutex> lock(m_buffers_mutex);
+        for (auto const &buffer : m_buffers)
+        {
+            std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+            pending += buffer->contents;
+            buffer->contents.clear();
+        }
+    }
+    if (pending.empty())
+        return;
+    m_stream->write(pending.data(), pending.size());
+    m_stream->flush();
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "guis.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sss::guis
+{
+    class logger_t
+    {
+    private:
+        /**
+         * @brief Pending messages written by a single thread
+         */
+        struct buffer_t
+        {
+            /**
+             * @brief The thread that writes into this buffer
+             */
+            std::thread::id owner;
+            /**
+             * @brief Guards `contents` against the draining thread
+             */
+            std::mutex mutex;
+            /**
+             * @brief Formatted messages that are yet to be written
+             */
+            std::string contents;
+        };
+        /**
+         * @brief Output stream for log messages
+         */
+        std::ostream *m_stream;
+        /**
+         * @brief The most verbose level of message that is written
+         */
+        log_level_t const m_level;
+        /**
+         * @brief Unique identifier of this logger (used to validate thread local lookups)
+         */
+        std::uint64_t const m_identifier;
+        /**
+         * @brief Guards `m_buffers`
+         */
+        std::mutex m_buffers_mutex;
+        /**
+         * @brief Per-thread message buffers
+         */
+        std::vector<std::unique_ptr<buffer_t>> m_buffers;
+        /**
+         * @brief Guards `m_stopping` and the draining thread wake up
+         */
+        std::mutex m_drain_mutex;
+        /**
+         * @brief Wakes up the draining thread
+         */
+        std::condition_variable m_drain_condition;
+        /**
+         * @brief Whether the draining thread should finish
+         */
+        bool m_stopping;
+        /**
+         * @brief Thread that asynchronously writes buffered messages to the stream
+         */
+        std::thread m_drain_thread;
+
+        /**
+         * @brief Get the buffer of the calling thread (creating it if needed)
+         * @return Buffer of the calling thread
+         */
+        buffer_t &thread_buffer();
+        /**
+         * @brief Queue a formatted message
+         * @param message The formatted message (including its line ending)
+         */
+        void write(std::string const &message);
+        /**
+         * @brief Write all buffered messages to the stream
+         */
+        void drain();
+
+    public:
+        /**
+         * @brief Construct a logger
+         * @param stream A `std::ostream` to write log messages to (if `nullptr` then nothing is logged)
+         * @param level The most verbose level of message to write
+         */
+        logger_t(std::ostream const *stream, log_level_t const level = log_level_t::debug);
+        /**
+         * @brief Deconstructor (writes any remaining messages)
+         */
+        ~logger_t();
+        logger_t(logger_t const &) = delete;
+        logger_t &operator=(logger_t const &) = delete;
+        /**
+         * @brief Whether messages of a level will be written
+         * @param level The level to check
+         * @return Whether messages of `level` are written
+         */
+        bool enabled(log_level_t const level) const;
+        /**
+         * @brief Log a message (the message is only formatted if `level` is enabled)
+         * @param level The level of the message
+         * @param name The name of the source of the message
+         * @param message Parts of the message to be concatenated
+         */
+        template <typename... message_t>
+        void log(log_level_t const level, std::string const &name, message_t const &...message)
+        {
+            if (!enabled(level))
+                return;
+            std::ostringstream formatted;
+            formatted << name << ": ";
+            (formatted << ... << message);
+            formatted << '\n';
+            write(formatted.str());
+        }
+        template <typename... message_t>
+        void error(std::string const &name, message_t const &...message) { log(log_level_t::error, name, message...); }
+        template <typename... message_t>
+        void warning(std::string const &name, message_t const &...message) { log(log_level_t::warning, name, message...); }
+        template <typename... message_t>
+        void info(std::string const &name, message_t const &...message) { log(log_level_t::info, name, message...); }
+        template <typename... message_t>
+        void debug(std::string const &name, message_t const &...message) { log(log_level_t::debug, name, message...); }
+    };
+}
@@ -0,0 +1,417 @@
+#include "output.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <zlib.h>
+
+using namespace sss::guis;
+
+namespace
+{
+    /**
+     * @brief Size of a tar block
+     */
+    constexpr std::size_t block_size = 512;
+
+    /**
+     * @brief Size of chunks that dependencies are streamed in
+     */
+    constexpr std::size_t chunk_size = 64 * 1024;
+
+    /**
+     * @brief Write an octal number into a tar header field
+     * @param field The field to write into
+     * @param size The size of the field (including the terminator)
+     * @param value The value to write
+     */
+    void octal_field(char *field, std::size_t const size, std::uintmax_t value)
+    {
+        std::memset(field, '0', size - 1);
+        field[size - 1] = '\0';
+        for (std::size_t i = size - 1; i > 0 && value > 0; i--)
+        {
+            field[i - 1] = static_cast<char>('0' + (value & 7));
+            value >>= 3;
+        }
+    }
+
+    /**
+     * @brief Get the path of the incomplete archive file
+     * @param file The location of the archive
+     * @return Location of the incomplete archive
+     */
+    std::filesystem::path partial_path(std::filesystem::path const &file)
+    {
+        return file.string() + ".partial";
+    }
+}
+
+struct archive_output_t::compressor_t
+{
+    compressor_t()
+    {
+        std::memset(&stream, 0, sizeof(stream));
+        // A window of 15 bits (+16 for a gzip wrapper); `deflateInit2` is avoided as its macro uses an old-style cast
+        if (deflateInit2_(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY, ZLIB_VERSION, static_cast<int>(sizeof(z_stream))) != Z_OK)
+            throw std::runtime_error("Failed to initialize archive compression");
+    }
+    ~compressor_t()
+    {
+        deflateEnd(&stream);
+    }
+    /**
+     * @brief zlib deflate state
+     */
+    z_stream stream;
+    /**
+     * @brief Buffer for compressed output
+     */
+    std::array<unsigned char, chunk_size> buffer;
+};
+
+directory_output_t::directory_output_t(std::filesystem::path const &directory)
+    : m_directory(std::filesystem::absolute(directory.lexically_normal()))
+{
+}
+
+void directory_output_t::open()
+{
+    if (!std::filesystem::exists(m_directory))
+    {
+        if (!std::filesystem::create_directories(m_directory))
+            throw std::runtime_error("Failed to create output directory");
+    }
+    else if (!std::filesystem::is_directory(m_directory))
+        throw std::runtime_error("There is already a file located as the output directory location");
+}
+
+void directory_output_t::close()
+{
+}
+
+bool directory_output_t::exists(std::filesystem::path const &path) const
+{
+    return std::filesystem::exists(m_directory / path);
+}
+
+std::vector<std::filesystem::path> directory_output_t::listing() const
+{
+    std::vector<std::filesystem::path> paths = {};
+    if (!std::filesystem::is_directory(m_directory))
+        return paths;
+    for (auto const &entry : std::filesystem::recursive_directory_iterator(m_directory))
+        paths.push_back(entry.path().lexically_relative(m_directory));
+    return paths;
+}
+
+void directory_output_t::write(std::filesystem::path const &path, std::string const &contents)
+{
+    std::filesystem::path const filepath = m_directory / path;
+    std::filesystem::create_directories(filepath.parent_path());
+    std::ofstream file(filepath, std::ios::binary | std::ios::out);
+    if (!file)
+        throw std::runtime_error("Failed to open file for writing: " + filepath.string());
+    file.write(contents.data(), contents.size());
+}
+
+void directory_output_t::copy(std::filesystem::path const &source, std::filesystem::path const &path, bool const overwrite)
+{
+    std::filesystem::path const destination = m_directory / path;
+    std::filesystem::create_directories(destination.parent_path());
+    std::filesystem::copy_options copy_options = std::filesystem::copy_options::recursive;
+    if (overwrite)
+        copy_options |= std::filesystem::copy_options::overwrite_existing;
+    std::filesystem::copy(source, destination, copy_options);
+}
+
+memory_output_t::memory_output_t()
+    : m_files({}),
+      m_dependencies({})
+{
+}
+
+void memory_output_t::open()
+{
+}
+
+void memory_output_t::close()
+{
+}
+
+bool memory_output_t::exists(std::filesystem::path const &path) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::filesystem::path const normal_path = path.lexically_normal();
+    return (m_files.count(normal_path) || m_dependencies.count(normal_path));
+}
+
+std::vector<std::filesystem::path> memory_output_t::listing() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::filesystem::path> paths = {};
+    for (auto const &file : m_files)
+        paths.push_back(file.first);
+    for (auto const &dependency : m_dependencies)
+        paths.push_back(dependency.first);
+    return paths;
+}
+
+void memory_output_t::write(std::filesystem::path const &path, std::string const &contents)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_files[path.lexically_normal()] = contents;
+}
+
+void memory_output_t::copy(std::filesystem::path const &source, std::filesystem::path const &path, bool const overwrite)
+{
+    // Refer to each file of a directory individually
+    std::vector<std::pair<std::filesystem::path, std::filesystem::path>> files = {};
+    if (std::filesystem::is_directory(source))
+    {
+        for (auto const &entry : std::filesystem::recursive_directory_iterator(source))
+        {
+            if (entry.is_regular_file())
+                files.push_back({entry.path(), (path / entry.path().lexically_relative(source)).lexically_normal()});
+        }
+    }
+    else
+        files.push_back({source, path.lexically_normal()});
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto const &[file, destination] : files)
+    {
+        if (!overwrite && (m_files.count(destination) || m_dependencies.count(destination)))
+            throw std::runtime_error("Unable to copy \"" + file.string() + "\" as a file already exists at \"" + destination.string() + "\"");
+    }
+    for (auto const &[file, destination] : files)
+        m_dependencies[destination] = file;
+}
+
+std::map<std::filesystem::path, std::string> const &memory_output_t::files() const
+{
+    return m_files;
+}
+
+std::map<std::filesystem::path, std::filesystem::path> const &memory_output_t::dependencies() const
+{
+    return m_dependencies;
+}
+
+archive_output_t::archive_output_t(std::filesystem::path const &file, bool const compress)
+    : m_file(std::filesystem::absolute(file.lexically_normal())),
+      m_file_stream(std::make_unique<std::ofstream>(partial_path(m_file), std::ios::binary | std::ios::out | std::ios::trunc)),
+      m_stream(*m_file_stream),
+      m_compressor(nullptr),
+      m_entries({}),
+      m_time(static_cast<long long>(std::time(nullptr))),
+      m_closed(false)
+{
+    if (!(*m_file_stream))
+        throw std::runtime_error("Failed to open archive for writing: " + m_file.string());
+    if (compress)
+        m_compressor = std::make_unique<compressor_t>();
+}
+
+archive_output_t::archive_output_t(std::ostream &stream, bool const compress)
+    : m_file(),
+      m_file_stream(nullptr),
+      m_stream(stream),
+      m_compressor(nullptr),
+      m_entries({}),
+      m_time(static_cast<long long>(std::time(nullptr))),
+      m_closed(false)
+{
+    if (compress)
+        m_compressor = std::make_unique<compressor_t>();
+}
+
+archive_output_t::~archive_output_t()
+{
+    if (m_file_stream && !m_closed)
+    {
+        m_file_stream->close();
+        std::error_code error;
+        std::filesystem::remove(partial_path(m_file), error);
+    }
+}
+
+void archive_output_t::emit(char const *data, std::size_t const size, bool const finish)
+{
+    if (!m_compressor)
+    {
+        m_stream.write(data, size);
+        return;
+    }
+    z_stream &stream = m_compressor->stream;
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    stream.avail_in = static_cast<uInt>(size);
+    int const flush = finish ? Z_FINISH : Z_NO_FLUSH;
+    int result = Z_OK;
+    do
+    {
+        stream.next_out = m_compressor->buffer.data();
+        stream.avail_out = static_cast<uInt>(m_compressor->buffer.size());
+        result = deflate(&stream, flush);
+        if (result == Z_STREAM_ERROR)
+            throw std::runtime_error("Failed to compress archive");
+        m_stream.write(reinterpret_cast<char const *>(m_compressor->buffer.data()), m_compressor->buffer.size() - stream.avail_out);
+    } while (stream.avail_out == 0 || (flush == Z_FINISH && result != Z_STREAM_END));
+}
+
+void archive_output_t::header(std::filesystem::path const &path, std::uintmax_t const size)
+{
+    std::string const name = path.lexically_normal().generic_string();
+    if (name.empty())
+        throw std::runtime_error("Unable to add an unnamed entry to an archive");
+    m_entries.insert(path.lexically_normal()); // Repeated entries replace earlier ones when extracted
+
+    std::array<char, block_size> block;
+
+    /**
+     * @brief Fill and write a header block
+     * @param entry_name The name field
+     * @param prefix The prefix field
+     * @param entry_size The size of the entry
+     * @param type The type of the entry
+     */
+    auto const write_header = [&](std::string const &entry_name, std::string const &prefix, std::uintmax_t const entry_size, char const type)
+    {
+        block.fill('\0');
+        std::memcpy(block.data(), entry_name.data(), std::min<std::size_t>(entry_name.size(), 100));
+        octal_field(block.data() + 100, 8, 0644);
+        octal_field(block.data() + 108, 8, 0);
+        octal_field(block.data() + 116, 8, 0);
+        octal_field(block.data() + 124, 12, entry_size);
+        octal_field(block.data() + 136, 12, static_cast<std::uintmax_t>(m_time));
+        block[156] = type;
+        std::memcpy(block.data() + 257, "ustar", 6);
+        std::memcpy(block.data() + 263, "00", 2);
+        std::memcpy(block.data() + 345, prefix.data(), std::min<std::size_t>(prefix.size(), 155));
+        // The checksum is calculated with its own field treated as spaces
+        std::memset(block.data() + 148, ' ', 8);
+        unsigned int checksum = 0;
+        for (char const character : block)
+            checksum += static_cast<unsigned char>(character);
+        octal_field(block.data() + 148, 7, checksum);
+        block[155] = ' ';
+        emit(block.data(), block.size());
+    };
+
+    if (name.size() <= 100)
+    {
+        write_header(name, "", size, '0');
+        return;
+    }
+    // Split long names between the prefix and name fields (on a directory separator)
+    std::size_t const split = name.rfind('/', 155);
+    if (split != std::string::npos && split > 0 && (name.size() - split - 1) <= 100 && (name.size() - split - 1) > 0)
+    {
+        write_header(name.substr(split + 1), name.substr(0, split), size, '0');
+        return;
+    }
+    // Otherwise use a GNU long name entry
+    write_header("././@LongLink", "", name.size() + 1, 'L');
+    emit(name.c_str(), name.size() + 1);
+    pad(name.size() + 1);
+    write_header(name.substr(0, 100), "", size, '0');
+}
+
+void archive_output_t::pad(std::uintmax_t const size)
+{
+    static std::array<char, block_size> const padding = {};
+    std::size_t const remainder = static_cast<std::size_t>(size % block_size);
+    if (remainder != 0)
+        emit(padding.data(), block_size - remainder);
+}
+
+void archive_output_t::open()
+{
+}
+
+void archive_output_t::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_closed)
+        return;
+    // An archive ends with two empty blocks
+    std::array<char, block_size * 2> const end = {};
+    emit(end.data(), end.size());
+    if (m_compressor)
+        emit(nullptr, 0, true);
+    m_stream.flush();
+    if (!m_stream)
+        throw std::runtime_error("Failed to write archive");
+    if (m_file_stream)
+    {
+        m_file_stream->close();
+        std::filesystem::rename(partial_path(m_file), m_file);
+    }
+    m_closed = true;
+}
+
+bool archive_output_t::exists(std::filesystem::path const &path) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.count(path.lexically_normal());
+}
+
+std::vector<std::filesystem::path> archive_output_t::listing() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::vector<std::filesystem::path>(m_entries.begin(), m_entries.end());
+}
+
+void archive_output_t::write(std::filesystem::path const &path, std::string const &contents)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    header(path, contents.size());
+    emit(contents.data(), contents.size());
+    pad(contents.size());
+}
+
+void archive_output_t::copy(std::filesystem::path const &source, std::filesystem::path const &path, bool const overwrite)
+{
+    std::vector<std::pair<std::filesystem::path, std::filesystem::path>> files = {};
+    if (std::filesystem::is_directory(source))
+    {
+        for (auto const &entry : std::filesystem::recursive_directory_iterator(source))
+        {
+            if (entry.is_regular_file())
+                files.push_back({entry.path(), path / entry.path().lexically_relative(source)});
+        }
+    }
+    else
+        files.push_back({source, path});
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto const &[file, destination] : files)
+    {
+        if (!overwrite && m_entries.count(destination.lexically_normal()))
+            throw std::runtime_error("Unable to copy \"" + file.string() + "\" as a file already exists at \"" + destination.string() + "\"");
+    }
+    for (auto const &[file, destination] : files)
+    {
+        std::ifstream stream(file, std::ios::binary);
+        if (!stream)
+            throw std::runtime_error("Failed to open file for reading: " + file.string());
+        std::uintmax_t const size = std::filesystem::file_size(file);
+        header(destination, size);
+        // Stream the file so that large dependencies are never held in memory
+        std::vector<char> chunk(chunk_size);
+        std::uintmax_t remaining = size;
+        while (remaining > 0)
+        {
+            std::size_t const amount = static_cast<std::size_t>(std::min<std::uintmax_t>(remaining, chunk.size()));
+            if (!stream.read(chunk.data(), amount))
+                throw std::runtime_error("Failed to read file: " + file.string());
+            emit(chunk.data(), amount);
+            remaining -= amount;
+        }
+        pad(size);
+    }
+}
@@ -0,0 +1,130 @@
+#include "payload.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace sss::guis;
+
+std::vector<std::string> const payload_t::categories = {"html", "structure", "script", "stylesheet", "modules", "dependencies"};
+
+budget_t sss::guis::parse_budget(YAML::Node const &node)
+{
+    budget_t budget = {};
+    if (!node.IsDefined() || node.IsNull())
+        return budget;
+
+    /**
+     * @brief Parse a maximum amount of bytes
+     * @param value The YAML node of the maximum
+     * @param category The category of the maximum
+     */
+    auto const maximum = [&budget](YAML::Node const &value, std::string const &category)
+    {
+        try
+        {
+            if (value.IsScalar())
+            {
+                budget[category] = value.as<std::uintmax_t>();
+                return;
+            }
+        }
+        catch (YAML::BadConversion const &e)
+        {
+        }
+        throw std::runtime_error("Unable to parse the `" + category + "` budget since a number of bytes is expected");
+    };
+
+    if (node.IsMap())
+    {
+        for (auto const &entry : node)
+        {
+            std::string const category = entry.first.as<std::string>();
+            if (category != "total" && std::find(payload_t::categories.begin(), payload_t::categories.end(), category) == payload_t::categories.end())
+                throw std::runtime_error("Unknown budget category of `" + category + "`");
+            maximum(entry.second, category);
+        }
+    }
+    else
+        maximum(node, "total");
+    return budget;
+}
+
+payload_t::payload_t(std::string const &name)
+    : m_name(name),
+      m_files({}),
+      m_widget_types({})
+{
+}
+
+payload_t::~payload_t()
+{
+    m_files.clear();
+    m_widget_types.clear();
+}
+
+void payload_t::add_file(std::filesystem::path const &path, std::string const &category, std::uintmax_t const bytes)
+{
+    m_files.emplace(path.generic_string(), std::make_pair(category, bytes));
+}
+
+void payload_t::add_widgets(std::map<std::string, std::size_t> const &widget_types)
+{
+    for (auto const &widget_type : widget_types)
+        m_widget_types[widget_type.first] += widget_type.second;
+}
+
+void payload_t::merge(payload_t const &payload)
+{
+    m_files.insert(payload.m_files.begin(), payload.m_files.end());
+    add_widgets(payload.m_widget_types);
+}
+
+std::uintmax_t payload_t::bytes(std::string const &category) const
+{
+    std::uintmax_t total = 0;
+    for (auto const &file : m_files)
+    {
+        if (category == "total" || file.second.first == category)
+            total += file.second.second;
+    }
+    return total;
+}
+
+std::vector<std::string> payload_t::exceeded(budget_t const &budget) const
+{
+    std::vector<std::string> found = {};
+    for (auto const &maximum : budget)
+    {
+        std::uintmax_t const used = bytes(maximum.first);
+        if (used > maximum.second)
+            found.push_back(m_name + ": The " + maximum.first + " payload of " + std::to_string(used) + " bytes exceeds its budget of " + std::to_string(maximum.second) + " bytes");
+    }
+    return found;
+}
+
+nlohmann::json payload_t::report(std::size_t const largest_files) const
+{
+    nlohmann::json report = {{"name", m_name}};
+    nlohmann::json bytes_report = nlohmann::json::object();
+    for (auto const &category : categories)
+        bytes_report[category] = bytes(category);
+    bytes_report["total"] = bytes("total");
+    report["bytes"] = bytes_report;
+
+    std::size_t widgets = 0;
+    for (auto const &widget_type : m_widget_types)
+        widgets += widget_type.second;
+    report["widgets"] = widgets;
+    report["types"] = m_widget_types;
+
+    std::vector<std::pair<std::string, std::pair<std::string, std::uintmax_t>>> files(m_files.begin(), m_files.end());
+    std::stable_sort(files.begin(), files.end(), [](auto const &a, auto const &b)
+                     { return a.second.second > b.second.second; });
+    if (files.size() > largest_files)
+        files.resize(largest_files);
+    nlohmann::json largest = nlohmann::json::array();
+    for (auto const &file : files)
+        largest.push_back({{"path", file.first}, {"category", file.second.first}, {"bytes", file.second.second}});
+    report["largest"] = largest;
+    return report;
+}
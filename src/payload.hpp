@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+namespace sss::guis
+{
+    /**
+     * @brief Maximum bytes of each payload category (where `total` covers every category)
+     */
+    using budget_t = std::map<std::string, std::uintmax_t>;
+
+    /**
+     * @brief Parse a budget, either as a maximum total of bytes or as a mapping of categories to maximum bytes
+     * @param node The YAML node of the budget
+     * @return The budget (empty if the node is not defined or null)
+     */
+    budget_t parse_budget(YAML::Node const &node);
+
+    class payload_t
+    {
+    private:
+        /**
+         * @brief The name of the payload (only used for reports)
+         */
+        std::string const m_name;
+        /**
+         * @brief Files of the payload with their category and bytes (keyed by path)
+         */
+        std::map<std::string, std::pair<std::string, std::uintmax_t>> m_files;
+        /**
+         * @brief Amount of widgets of each type
+         */
+        std::map<std::string, std::size_t> m_widget_types;
+
+    public:
+        /**
+         * @brief The categories of payload files
+         */
+        static std::vector<std::string> const categories;
+        /**
+         * @brief Construct an empty payload
+         * @param name The name of the payload (only used for reports)
+         */
+        payload_t(std::string const &name);
+        /**
+         * @brief Deconstructor
+         */
+        ~payload_t();
+        /**
+         * @brief Add a file to the payload (a file is only counted once)
+         * @param path The path of the file
+         * @param category The category of the file (one of `categories`)
+         * @param bytes The size of the file
+         */
+        void add_file(std::filesystem::path const &path, std::string const &category, std::uintmax_t const bytes);
+        /**
+         * @brief Add widgets to the payload
+         * @param widget_types Amount of widgets of each type
+         */
+        void add_widgets(std::map<std::string, std::size_t> const &widget_types);
+        /**
+         * @brief Add all files and widgets of another payload
+         * @param payload The payload to add
+         */
+        void merge(payload_t const &payload);
+        /**
+         * @brief Get the bytes of a category
+         * @param category The category (or `total` for every category)
+         * @return Bytes of the category
+         */
+        std::uintmax_t bytes(std::string const &category) const;
+        /**
+         * @brief Check the payload against a budget
+         * @param budget The budget to check against
+         * @return Descriptions of every category that exceeds the budget
+         */
+        std::vector<std::string> exceeded(budget_t const &budget) const;
+        /**
+         * @brief Describe the payload
+         * @param largest_files The amount of largest files to list
+         * @return JSON report of the payload
+         */
+        nlohmann::json report(std::size_t const largest_files = 10) const;
+    };
+}
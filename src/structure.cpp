@@ -1,4 +1,5 @@
 #include "structure.hpp"
+#include "templates.hpp"
 
 #include <algorithm>
 #include <cstdint>
@@ -6,7 +7,6 @@
 #include <functional>
 #include <iostream>
 #include <map>
-#include <mutex>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
 #include <string>
@@ -17,21 +17,6 @@ using namespace sss::guis;
 
 namespace
 {
-    /**
-     * @brief Write output to debug output stream
-     * @param debug_stream Pointer to a output stream (if nullptr then function will do nothing)
-     * @param message Message to be written to debug output
-     */
-    void debug(std::ostream *debug_stream, std::string const &name, std::string const &message)
-    {
-        if (debug_stream == nullptr)
-            return;
-        static std::mutex debug_mutex;
-        std::lock_guard<std::mutex> lock(debug_mutex);
-        (*debug_stream) << name << ": " << message << std::endl;
-        debug_stream->flush();
-    }
-
     /**
      * @brief Counts the occurrence of widget types
      * @param widgets The widgets to count against
@@ -108,89 +93,228 @@ namespace
         }
         return json_value;
     }
-}
 
-structure_t::structure_t(std::string const &file, std::string const &name, std::ostream const *debug_stream)
-    : m_widgets({}),
-      m_widget_types({}),
-      m_widget_contents({}),
-      m_parsed_files({}),
-      m_name(name),
-      m_debug_stream(const_cast<std::ostream *>(debug_stream))
-{
-    parse_file(std::filesystem::absolute(file));
-}
+    /**
+     * @brief Key of the object that references a shared subtree within a minified structure (never produced by key interning)
+     */
+    std::string const shared_reference_key = "";
 
-structure_t::~structure_t()
-{
-    m_widgets.clear();
-    m_widget_types.clear();
-    m_widget_contents.clear();
-    m_parsed_files.clear();
-}
+    /**
+     * @brief Minimum serialized size of a subtree for it to be worth sharing (larger than its reference)
+     */
+    std::size_t const minimum_shared_size = 12;
 
-void structure_t::parse_file(std::filesystem::path const &file)
-{
-    if (m_parsed_files.count(file))
+    /**
+     * @brief Count the occurrences of each object key
+     * @param node The JSON node to count against
+     * @param occurrences Occurrences of each key
+     */
+    void count_keys(nlohmann::json const &node, std::map<std::string, std::size_t> &occurrences)
     {
-        debug(m_debug_stream, m_name, "Additional reference was made to \"" + file.string() + "\", this could mean there are circular dependencies (ignored)");
-        return;
+        if (node.is_object())
+        {
+            for (auto const &item : node.items())
+            {
+                occurrences[item.key()]++;
+                count_keys(item.value(), occurrences);
+            }
+        }
+        else if (node.is_array())
+        {
+            for (auto const &item : node)
+                count_keys(item, occurrences);
+        }
     }
-    if (!std::filesystem::exists(file))
-        throw std::runtime_error("Unable to find dependency file of \"" + file.string() + "\"");
 
-    debug(m_debug_stream, m_name, "Parsing configuration dependency \"" + file.string() + "\"...");
-    try
+    /**
+     * @brief Replace object keys with their index within the key dictionary
+     * @param node The JSON node to intern the keys of
+     * @param dictionary Keys and their index (as a string)
+     * @returns JSON node with interned keys
+     */
+    nlohmann::json intern_keys(nlohmann::json const &node, std::unordered_map<std::string, std::string> const &dictionary)
     {
-        std::vector<YAML::Node> documents = {};
-        for (auto &document : YAML::LoadAllFromFile(file.string()))
+        if (node.is_object())
         {
-            if (!document.IsDefined() || !document.IsNull())
-                documents.push_back(document);
+            nlohmann::json interned = nlohmann::json::object();
+            for (auto const &item : node.items())
+                interned[dictionary.at(item.key())] = intern_keys(item.value(), dictionary);
+            return interned;
         }
-        if (documents.empty())
+        if (node.is_array())
         {
-            debug(m_debug_stream, m_name, "Empty dependency file located at \"" + file.string() + "\"");
+            nlohmann::json interned = nlohmann::json::array();
+            for (auto const &item : node)
+                interned.push_back(intern_keys(item, dictionary));
+            return interned;
+        }
+        return node;
+    }
+
+    /**
+     * @brief Count the occurrences of each (non-scalar) subtree
+     * @param node The JSON node to count against
+     * @param occurrences Occurrences of each serialized subtree
+     */
+    void count_subtrees(nlohmann::json const &node, std::unordered_map<std::string, std::size_t> &occurrences)
+    {
+        if (!node.is_structured())
             return;
+        occurrences[node.dump()]++;
+        for (auto const &item : node)
+            count_subtrees(item, occurrences);
+    }
+
+    /**
+     * @brief Replace repeated subtrees with references to a shared table
+     * @param node The JSON node to deduplicate
+     * @param occurrences Occurrences of each serialized subtree
+     * @param indices Serialized subtrees and their index within the shared table
+     * @param shared The shared table of subtrees
+     * @returns Deduplicated JSON node
+     */
+    nlohmann::json share_subtrees(nlohmann::json const &node, std::unordered_map<std::string, std::size_t> const &occurrences, std::unordered_map<std::string, std::size_t> &indices, nlohmann::json &shared)
+    {
+        if (!node.is_structured())
+            return node;
+        std::string const serialized = node.dump();
+        bool const repeated = (serialized.size() >= minimum_shared_size && occurrences.at(serialized) > 1);
+        if (repeated)
+        {
+            auto const index = indices.find(serialized);
+            if (index != indices.end())
+                return {{shared_reference_key, index->second}};
+        }
+        nlohmann::json deduplicated = node;
+        for (auto &item : deduplicated)
+            item = share_subtrees(item, occurrences, indices, shared);
+        if (!repeated)
+            return deduplicated;
+        indices[serialized] = shared.size();
+        shared.push_back(deduplicated);
+        return {{shared_reference_key, indices[serialized]}};
+    }
+
+    /**
+     * @brief Markup of a widget that is only rendered at runtime (keeps the position of the widget within its parent)
+     */
+    std::string const runtime_placeholder = "<div></div>";
+
+    /**
+     * @brief Get the text that the runtime would show for a scalar property
+     * @param node The YAML node of the property
+     * @param text The text of the property
+     * @returns Whether the property could be shown as text
+     */
+    bool scalar_text(YAML::Node const &node, std::string &text)
+    {
+        if (!node.IsDefined() || !node.IsScalar())
+            return false;
+        nlohmann::json const value = yaml_to_json(node);
+        text = (value.is_string() ? value.get<std::string>() : value.dump());
+        return true;
+    }
+
+    /**
+     * @brief Get the CSS size of a layout track
+     * @param node The YAML node of the track size
+     * @param size The CSS size of the track
+     * @returns Whether the track size is valid
+     */
+    bool track_size(YAML::Node const &node, std::string &size)
+    {
+        if (!node.IsScalar())
+            return false;
+        nlohmann::json const value = yaml_to_json(node);
+        if (!value.is_number() || value.get<double>() < 0)
+            return false;
+        size = (value.get<double>() == 0 ? "auto" : value.dump() + "fr");
+        return true;
+    }
+
+    /**
+     * @brief Get the markup of an empty cell (or `null` widget)
+     * @param prerendered Whether the runtime should hydrate the markup
+     * @returns HTML markup of the cell
+     */
+    std::string void_markup(bool const prerendered)
+    {
+        return std::string("<div class=\"void\"") + (prerendered ? " prerendered" : "") + "><template shadowrootmode=\"closed\"><style>:host{all:initial;display:none;}</style></template></div>";
+    }
+
+    /**
+     * @brief Collect the names of the widgets that a widget configuration references (via `object`)
+     * @param contents The widget configuration (with references by name)
+     * @param references The referenced names (in the order they appear)
+     */
+    void object_references(YAML::Node const &contents, std::vector<std::string> &references)
+    {
+        if (contents.IsSequence())
+        {
+            for (auto const &item : contents)
+                object_references(item, references);
+        }
+        else if (contents.IsMap())
+        {
+            for (auto const &entry : contents)
+            {
+                if (entry.first.as<std::string>() == "object" && entry.second.IsScalar())
+                    references.push_back(entry.second.as<std::string>());
+                else
+                    object_references(entry.second, references);
+            }
         }
-        for (auto &&contents : documents)
+    }
+
+    /**
+     * @brief Convert the YAML documents of a widget configuration file into records
+     * @param file The file that the documents were loaded from (only used for error messages)
+     * @param yaml_documents The YAML documents of the file
+     * @returns Records of the widgets and dependencies declared in each document
+     */
+    std::vector<document_record_t> parse_documents(std::filesystem::path const &file, std::vector<YAML::Node> const &yaml_documents)
+    {
+        std::vector<document_record_t> documents = {};
+        for (auto const &contents : yaml_documents)
         {
+            if (contents.IsDefined() && contents.IsNull())
+                continue;
             if (!contents.IsMap())
                 throw std::runtime_error("Unable to parse non-mappable structure within \"" + file.string() + "\"");
 
+            document_record_t document = {};
             for (auto const &widget_entry : contents)
             {
-                widget_name_t widget_name;
+                widget_record_t widget = {};
                 try
                 {
-                    widget_name = widget_entry.first.as<widget_name_t>();
+                    widget.name = widget_entry.first.as<std::string>();
                 }
                 catch (std::exception const &e)
                 {
                     throw std::runtime_error("Failed to parse the name (string) of a widget");
                 }
 
-                if (widget_name == "dependencies")
+                if (widget.name == "dependencies")
                     continue;
 
                 YAML::Node const type = widget_entry.second["type"];
                 if (!type.IsDefined())
-                    throw std::runtime_error("The widget `" + widget_name + "` within \"" + file.string() + "\" has no `type` definition");
+                    throw std::runtime_error("The widget `" + widget.name + "` within \"" + file.string() + "\" has no `type` definition");
 
-                widget_type_t widget_type;
                 try
                 {
-                    widget_type = type.as<widget_type_t>();
+                    widget.type = type.as<std::string>();
                 }
                 catch (std::exception const &e)
                 {
-                    throw std::runtime_error("Failed to parse the type (string) of widget `" + widget_name + "`");
+                    throw std::runtime_error("Failed to parse the type (string) of widget `" + widget.name + "`");
                 }
 
                 // Create a mutable copy of the node to remove the "type" key
-                widget_contents_t widget_content_node = widget_entry.second;
-                widget_content_node.remove("type");
-                add_widget(widget_name, widget_type, widget_content_node);
+                widget.contents = widget_entry.second;
+                widget.contents.remove("type");
+                document.widgets.push_back(widget);
             }
 
             YAML::Node const dependencies = contents["dependencies"];
@@ -202,43 +326,102 @@ void structure_t::parse_file(std::filesystem::path const &file)
                     {
                         if (!dependency_node.IsScalar())
                             throw std::runtime_error("Expected a string path for a dependency in \"" + file.string() + "\"");
-
-                        std::filesystem::path dependency_relative_path;
                         try
                         {
-                            dependency_relative_path = dependency_node.as<std::string>();
+                            document.dependencies.push_back(dependency_node.as<std::string>());
                         }
                         catch (std::exception const &e)
                         {
                             throw std::runtime_error("Expected a string path for a dependency in \"" + file.string() + "\"");
                         }
-
-                        // The 'file_path' is the absolute path of the current YAML file being parsed.
-                        // We want to resolve 'dependency_relative_path' relative to the directory of 'file_path'.
-                        std::filesystem::path parent_dir = std::filesystem::absolute(file).parent_path();
-
-                        // Construct the absolute path of the dependency
-                        std::filesystem::path resolved_dependency_path;
-                        if (dependency_relative_path.is_absolute())
-                            resolved_dependency_path = dependency_relative_path;
-                        else
-                            resolved_dependency_path = parent_dir / dependency_relative_path;
-
-                        parse_file(resolved_dependency_path.string());
                     }
                 }
                 else if (dependencies.Type() != YAML::NodeType::Null)
                     throw std::runtime_error("Unable to parse `dependencies` since a list is expected");
             }
+            documents.push_back(document);
         }
+        return documents;
     }
-    catch (std::runtime_error const &e)
+}
+
+structure_t::structure_t(std::string const &file, std::string const &name, logger_t &logger, input_t const &input, cache_t const &cache)
+    : m_widgets({}),
+      m_widget_types({}),
+      m_widget_contents({}),
+      m_parsed_files({}),
+      m_numeric_references(true),
+      m_name(name),
+      m_logger(logger),
+      m_cache(cache),
+      m_input(input)
+{
+    parse_file(std::filesystem::absolute(file));
+}
+
+structure_t::~structure_t()
+{
+    m_widgets.clear();
+    m_widget_types.clear();
+    m_widget_contents.clear();
+    m_parsed_files.clear();
+}
+
+void structure_t::parse_file(std::filesystem::path const &file)
+{
+    if (m_parsed_files.count(file))
     {
-        throw e;
+        m_logger.warning(m_name, "Additional reference was made to \"", file.string(), "\", this could mean there are circular dependencies (ignored)");
+        return;
     }
-    catch (std::exception const &e)
+    if (!m_input.status(file).exists)
+        throw std::runtime_error("Unable to find dependency file of \"" + file.string() + "\"");
+    m_parsed_files.insert(file);
+
+    std::vector<document_record_t> documents = {};
+    std::string contents;
+    if (m_cache.load(file, documents, contents))
+        m_logger.info(m_name, "Loaded cached configuration dependency \"", file.string(), "\"");
+    else
+    {
+        m_logger.info(m_name, "Parsing configuration dependency \"", file.string(), "\"...");
+        try
+        {
+            documents = parse_documents(file, YAML::LoadAll(contents));
+            m_cache.store(file, contents, documents);
+        }
+        catch (std::runtime_error const &e)
+        {
+            throw e;
+        }
+        catch (std::exception const &e)
+        {
+            throw std::runtime_error("Unable to parse dependency file of \"" + file.string() + "\"");
+        }
+    }
+    if (documents.empty())
     {
-        throw std::runtime_error("Unable to parse dependency file of \"" + file.string() + "\"");
+        m_logger.warning(m_name, "Empty dependency file located at \"", file.string(), "\"");
+        return;
+    }
+    for (auto const &document : documents)
+    {
+        for (auto const &widget : document.widgets)
+            add_widget(widget.name, widget.type, widget.contents);
+
+        // The dependencies are resolved relative to the directory of the file being parsed
+        std::filesystem::path const parent_dir = std::filesystem::absolute(file).parent_path();
+        for (std::filesystem::path const dependency_relative_path : document.dependencies)
+        {
+            // Construct the absolute path of the dependency
+            std::filesystem::path resolved_dependency_path;
+            if (dependency_relative_path.is_absolute())
+                resolved_dependency_path = dependency_relative_path;
+            else
+                resolved_dependency_path = parent_dir / dependency_relative_path;
+
+            parse_file(resolved_dependency_path.string());
+        }
     }
 }
 
@@ -330,19 +513,19 @@ void structure_t::prune_references()
 
     if (widgets_to_remove.size() == m_widgets.size())
     {
-        debug(m_debug_stream, m_name, "Pruning all " + std::to_string(m_widgets.size()) + " widget(s)!");
+        m_logger.info(m_name, "Pruning all ", m_widgets.size(), " widget(s)!");
         m_widgets.clear();
         m_widget_contents.clear();
         m_widget_types.clear();
         return;
     }
     else if (widgets_to_remove.size() > 0)
-        debug(m_debug_stream, m_name, "Pruning " + std::to_string(widgets_to_remove.size()) + " widget" + (m_widgets.size() != 1 ? "s" : "") + "...");
+        m_logger.info(m_name, "Pruning ", widgets_to_remove.size(), " widget", (m_widgets.size() != 1 ? "s" : ""), "...");
     for (widget_name_t const &name : widgets_to_remove)
     {
         m_widgets.erase(name);
         m_widget_contents.erase(name);
-        debug(m_debug_stream, m_name, "Pruned `" + name + "`");
+        m_logger.debug(m_name, "Pruned `", name, "`");
     }
 
     std::map<widget_type_identifier_t, int> type_occurrences = count_widget_type_occurrences(m_widgets);
@@ -374,9 +557,51 @@ void structure_t::prune_references()
     m_widget_types = new_widget_types;
 }
 
+std::vector<structure_t::widget_name_t> structure_t::instantiation_order(std::size_t &depth) const
+{
+    std::map<widget_name_t, std::vector<widget_name_t>> children = {};
+    for (auto const &pair : m_widget_contents)
+        object_references(pair.second, children[pair.first]);
+
+    // Depth first search from `main`, where a reference back to a widget on the current path is a cycle
+    std::set<widget_name_t> visited = {};
+    std::vector<widget_name_t> path = {};
+    std::vector<widget_name_t> postorder = {};
+    std::function<void(widget_name_t const &)> visit = [&](widget_name_t const &name)
+    {
+        if (std::find(path.begin(), path.end(), name) != path.end())
+        {
+            std::string cycle;
+            for (auto const &step : path)
+                cycle += "`" + step + "` -> ";
+            throw std::runtime_error("Widgets reference each other in a cycle: " + cycle + "`" + name + "`");
+        }
+        if (!visited.insert(name).second)
+            return; // Referenced by more than one widget (which is allowed)
+        path.push_back(name);
+        for (auto const &child : children[name])
+            visit(child);
+        path.pop_back();
+        postorder.push_back(name);
+    };
+    visit("main");
+
+    std::vector<widget_name_t> const order(postorder.rbegin(), postorder.rend());
+    std::map<widget_name_t, std::size_t> depths = {};
+    depth = 0;
+    for (auto const &name : order)
+    {
+        std::size_t const current = depths[name];
+        depth = std::max(depth, current);
+        for (auto const &child : children[name])
+            depths[child] = std::max(depths[child], current + 1);
+    }
+    return order;
+}
+
 void structure_t::number_references()
 {
-    debug(m_debug_stream, m_name, "Updating references for numeric positioning...");
+    m_logger.info(m_name, "Updating references for numeric positioning...");
     std::function<YAML::Node(YAML::Node)> number_references_recursive =
         [&](YAML::Node current_node) -> YAML::Node
     {
@@ -408,8 +633,9 @@ void structure_t::number_references()
                 auto const widget_it = m_widgets.find(object_name);
                 if (widget_it != m_widgets.end())
                 {
-                    current_node[key] = std::distance(m_widgets.begin(), widget_it); // Get the index
-                    debug(m_debug_stream, m_name, "Resolved reference to object `" + object_name + "` with index: " + std::to_string(current_node[key].as<int>()));
+                    auto const index = std::distance(m_widgets.begin(), widget_it); // Get the index
+                    current_node[key] = index;
+                    m_logger.debug(m_name, "Resolved reference to object `", object_name, "` with index: ", index);
                 }
                 else
                     throw std::runtime_error("An unexpected error occurred whilst handling a dangling child object reference for `" + object_name + "`"); // Should never be thrown (expected to be caught prior in `prune_references` method)
@@ -429,6 +655,12 @@ void structure_t::number_references()
 std::string structure_t::build(bool const numeric_references)
 {
     prune_references();
+    if (m_widgets.count("main") == 0)
+        throw std::runtime_error("No `main` widget was found!");
+    std::size_t depth = 0;
+    std::vector<widget_name_t> const order = instantiation_order(depth);
+    m_logger.debug(m_name, "Ordered ", order.size(), " reachable widget(s) with a reference depth of ", depth);
+    m_numeric_references = numeric_references;
     if (numeric_references)
         number_references();
 
@@ -439,7 +671,7 @@ std::string structure_t::build(bool const numeric_references)
         if (numeric_references)
         {
             main = std::distance(m_widgets.begin(), it); // Get index of 'main' widget
-            debug(m_debug_stream, m_name, "Resolved reference to object `main` with index: " + std::to_string(main));
+            m_logger.debug(m_name, "Resolved reference to object `main` with index: ", main);
         }
     }
     else
@@ -461,6 +693,7 @@ std::string structure_t::build(bool const numeric_references)
             widgets_array.push_back(widget_entry);
         }
         output_json["widgets"] = widgets_array;
+        minify(output_json);
     }
     else
     {
@@ -475,5 +708,362 @@ std::string structure_t::build(bool const numeric_references)
         output_json["widgets"] = widgets_array;
     }
     output_json["types"] = m_widget_types;
+
+    // Lets the runtime decode reachable widgets in one pass (parents before children) and bound their nesting
+    std::map<widget_name_t, std::size_t> indices = {};
+    for (auto const &pair : m_widgets)
+        indices.emplace(pair.first, indices.size());
+    nlohmann::json order_json = nlohmann::json::array();
+    for (auto const &name : order)
+    {
+        if (numeric_references)
+            order_json.push_back(indices.at(name));
+        else
+            order_json.push_back(name);
+    }
+    output_json["order"] = order_json;
+    output_json["depth"] = depth;
     return output_json.dump();
 }
+
+void structure_t::minify(nlohmann::json &structure) const
+{
+    nlohmann::json &widgets = structure["widgets"];
+
+    // Intern keys (the most frequent keys receive the shortest indices)
+    std::map<std::string, std::size_t> key_occurrences = {};
+    for (auto const &widget : widgets)
+        count_keys(widget[1], key_occurrences);
+    std::vector<std::pair<std::string, std::size_t>> keys(key_occurrences.begin(), key_occurrences.end());
+    std::stable_sort(keys.begin(), keys.end(), [](auto const &a, auto const &b)
+                     { return a.second > b.second; });
+    nlohmann::json key_dictionary = nlohmann::json::array();
+    std::unordered_map<std::string, std::string> dictionary = {};
+    for (auto const &key : keys)
+    {
+        dictionary[key.first] = std::to_string(key_dictionary.size());
+        key_dictionary.push_back(key.first);
+    }
+    for (auto &widget : widgets)
+        widget[1] = intern_keys(widget[1], dictionary);
+
+    // Deduplicate identical subtrees
+    std::unordered_map<std::string, std::size_t> subtree_occurrences = {};
+    for (auto const &widget : widgets)
+        count_subtrees(widget[1], subtree_occurrences);
+    std::unordered_map<std::string, std::size_t> indices = {};
+    nlohmann::json shared = nlohmann::json::array();
+    for (auto &widget : widgets)
+        widget[1] = share_subtrees(widget[1], subtree_occurrences, indices, shared);
+
+    structure["keys"] = key_dictionary;
+    structure["shared"] = shared;
+    m_logger.info(m_name, "Minified structure with ", key_dictionary.size(), " interned key(s) and ", shared.size(), " shared subtree(s)");
+}
+
+std::set<std::string> structure_t::references(std::vector<std::string> const &properties) const
+{
+    std::set<std::string> found = {};
+    std::set<widget_name_t> visited = {};
+    std::vector<widget_name_t> pending = {"main"};
+
+    /**
+     * @brief Collect the asset paths of a property value
+     * @param value The YAML node of the property value
+     */
+    auto const collect = [&found](YAML::Node const &value)
+    {
+        if (value.IsScalar())
+            found.insert(value.as<std::string>());
+        else if (value.IsSequence())
+        {
+            for (auto const &item : value)
+            {
+                if (item.IsScalar())
+                    found.insert(item.as<std::string>());
+            }
+        }
+    };
+
+    /**
+     * @brief Find asset paths and child object references within a configuration
+     * @param contents YAML node
+     * @param type The type of the widget being searched
+     * @param top_level Whether the node is the configuration of the widget itself
+     */
+    std::function<void(YAML::Node const &, widget_type_t const &, bool const)> find_references_recursive =
+        [&](YAML::Node const &contents, widget_type_t const &type, bool const top_level)
+    {
+        if (contents.IsSequence())
+        {
+            for (auto const &item : contents)
+                find_references_recursive(item, type, false);
+            return;
+        }
+        if (!contents.IsMap())
+            return;
+        for (auto const &entry : contents)
+        {
+            std::string const key = entry.first.as<std::string>();
+            widget_name_t child_name;
+            if (key == "object" && resolve_reference(entry.second, child_name))
+                pending.push_back(child_name);
+            else if ((top_level && key == "source" && (type == "image" || type == "audio" || type == "video")) ||
+                     std::find(properties.begin(), properties.end(), key) != properties.end())
+                collect(entry.second);
+            else
+                find_references_recursive(entry.second, type, false);
+        }
+    };
+
+    while (!pending.empty())
+    {
+        widget_name_t const name = pending.back();
+        pending.pop_back();
+        auto const widget = m_widgets.find(name);
+        if (widget == m_widgets.end() || !visited.insert(name).second)
+            continue;
+        find_references_recursive(m_widget_contents.at(name), m_widget_types[widget->second], true);
+    }
+    return found;
+}
+
+std::map<structure_t::widget_type_t, std::size_t> structure_t::widget_type_counts() const
+{
+    std::map<widget_type_t, std::size_t> counts = {};
+    for (auto const &type_count : count_widget_type_occurrences(m_widgets))
+        counts[m_widget_types[type_count.first]] = type_count.second;
+    return counts;
+}
+
+std::set<structure_t::widget_type_t> structure_t::top_level_types(std::size_t const levels) const
+{
+    std::set<widget_type_t> types = {};
+    std::set<widget_name_t> visited = {};
+    std::vector<widget_name_t> level = {"main"};
+    std::vector<widget_name_t> next_level = {};
+
+    /**
+     * @brief Find child object references within a configuration
+     * @param contents YAML node
+     */
+    std::function<void(YAML::Node const &)> find_children_recursive = [&](YAML::Node const &contents)
+    {
+        if (contents.IsSequence())
+        {
+            for (auto const &item : contents)
+                find_children_recursive(item);
+            return;
+        }
+        if (!contents.IsMap())
+            return;
+        for (auto const &entry : contents)
+        {
+            widget_name_t child_name;
+            if (entry.first.as<std::string>() == "object" && resolve_reference(entry.second, child_name))
+                next_level.push_back(child_name);
+            else
+                find_children_recursive(entry.second);
+        }
+    };
+
+    for (std::size_t depth = 0; depth < levels && !level.empty(); ++depth)
+    {
+        next_level.clear();
+        for (auto const &name : level)
+        {
+            auto const widget = m_widgets.find(name);
+            if (widget == m_widgets.end() || !visited.insert(name).second)
+                continue;
+            types.insert(m_widget_types[widget->second]);
+            find_children_recursive(m_widget_contents.at(name));
+        }
+        level = next_level;
+    }
+    return types;
+}
+
+bool structure_t::resolve_reference(YAML::Node const &reference, widget_name_t &name) const
+{
+    if (!reference.IsDefined() || !reference.IsScalar())
+        return false;
+    if (!m_numeric_references)
+    {
+        name = reference.as<widget_name_t>();
+        return (m_widgets.count(name) > 0);
+    }
+    std::size_t index = 0;
+    try
+    {
+        index = reference.as<std::size_t>();
+    }
+    catch (YAML::BadConversion const &e)
+    {
+        return false;
+    }
+    if (index >= m_widgets.size())
+        return false;
+    name = std::next(m_widgets.begin(), static_cast<std::ptrdiff_t>(index))->first;
+    return true;
+}
+
+std::string structure_t::prerender_widget(widget_name_t const &name, std::set<widget_name_t> &rendering) const
+{
+    auto const widget = m_widgets.find(name);
+    auto const contents = m_widget_contents.find(name);
+    if (widget == m_widgets.end() || contents == m_widget_contents.end() || !rendering.insert(name).second)
+        return runtime_placeholder; // Recursive references are reported by the runtime
+    YAML::Node const &configuration = contents->second;
+    widget_type_t const &type = m_widget_types[widget->second];
+
+    /**
+     * @brief Render a child object reference
+     * @param reference The object reference
+     * @return HTML markup of the child
+     */
+    auto const child = [&](YAML::Node const &reference) -> std::string
+    {
+        widget_name_t child_name;
+        if (!resolve_reference(reference, child_name))
+            return runtime_placeholder;
+        return prerender_widget(child_name, rendering);
+    };
+
+    std::string markup = runtime_placeholder;
+    if (type == "null")
+        markup = void_markup(true);
+    else if (type == "layout")
+    {
+        YAML::Node const columns = configuration["columns"];
+        YAML::Node const rows = configuration["rows"];
+        YAML::Node const items = configuration["items"];
+        YAML::Node const gap = configuration["gap"];
+        do
+        {
+            if (!columns.IsSequence() || !rows.IsSequence())
+                break;
+            if (!items.IsDefined())
+            {
+                markup = "<div class=\"layout\" prerendered></div>"; // The runtime leaves a layout without items unstyled
+                break;
+            }
+            std::size_t const max_items = (columns.size() * rows.size());
+            if (!items.IsSequence() || items.size() > max_items)
+                break;
+            std::string columns_style;
+            std::string rows_style;
+            bool valid = true;
+            for (auto const &track : {std::make_pair(columns, &columns_style), std::make_pair(rows, &rows_style)})
+            {
+                for (auto const &size_node : track.first)
+                {
+                    std::string size;
+                    valid = (valid && track_size(size_node, size));
+                    *track.second += (track.second->empty() ? "" : " ") + size;
+                }
+            }
+            std::string gap_style;
+            if (gap.IsDefined())
+            {
+                bool gap_value = true;
+                if (!gap.IsScalar() || !YAML::convert<bool>::decode(gap, gap_value))
+                    valid = false;
+                else if (!gap_value)
+                    gap_style = "gap:0!important;grid-gap:0!important;";
+            }
+            if (!valid)
+                break;
+            std::string children;
+            for (auto const &item : items)
+            {
+                YAML::Node const object = item["object"];
+                if (!object.IsDefined())
+                {
+                    valid = false;
+                    break;
+                }
+                children += (object.IsNull() ? void_markup(false) : child(object));
+            }
+            if (!valid)
+                break;
+            for (std::size_t i = items.size(); i < max_items; ++i)
+                children += void_markup(false); // Fill the remaining cells
+            markup = "<div class=\"layout\" prerendered><template shadowrootmode=\"closed\"><style>:host{display:grid!important;grid-template-columns:" + columns_style + "!important;grid-template-rows:" + rows_style + "!important;" + gap_style + "}</style><slot></slot></template>" + children + "</div>";
+        } while (false);
+    }
+    else if (type == "container")
+    {
+        std::string title;
+        if (scalar_text(configuration["title"], title) && configuration["object"].IsDefined())
+            markup = "<fieldset class=\"container\" prerendered><legend>" + escape_html(title) + "</legend>" + child(configuration["object"]) + "</fieldset>";
+    }
+    else if (type == "tabs")
+    {
+        YAML::Node const items = configuration["items"];
+        YAML::Node const position = configuration["position"];
+        std::string position_value = "top";
+        std::set<std::string> tab_names = {};
+        std::string buttons;
+        bool valid = (items.IsSequence() && items.size() > 0);
+        if (valid)
+        {
+            for (auto const &item : items)
+            {
+                std::string tab_name;
+                if (!scalar_text(item["name"], tab_name) || !tab_names.insert(tab_name).second || !item["object"].IsDefined())
+                {
+                    valid = false;
+                    break;
+                }
+                buttons += std::string("<button") + (buttons.empty() ? " active" : "") + ">" + escape_html(tab_name) + "</button>";
+            }
+        }
+        if (position.IsDefined() && !(scalar_text(position, position_value) && (position_value == "top" || position_value == "right" || position_value == "bottom" || position_value == "left")))
+            valid = false;
+        if (valid) // Only the first tab is shown initially, the others are rendered at runtime
+            markup = "<div class=\"tabs\" position=\"" + position_value + "\" prerendered><div>" + buttons + "</div><div>" + child(items[0]["object"]) + "</div></div>";
+    }
+    else if (type == "text" || type == "banner")
+    {
+        std::string text;
+        std::string horizontal = (type == "text" ? "left" : "center");
+        std::string vertical = "middle";
+        bool valid = scalar_text(configuration["text"], text);
+        YAML::Node const alignment = configuration["align"];
+        if (valid && alignment.IsDefined())
+        {
+            if (alignment["horizontal"].IsDefined())
+                valid = (scalar_text(alignment["horizontal"], horizontal) && (horizontal == "left" || horizontal == "right" || horizontal == "center"));
+            if (valid && alignment["vertical"].IsDefined())
+                valid = (scalar_text(alignment["vertical"], vertical) && (vertical == "top" || vertical == "middle" || vertical == "bottom"));
+        }
+        std::string color_style;
+        if (valid && configuration["color"].IsDefined())
+        {
+            std::string color;
+            valid = (scalar_text(configuration["color"], color) && !color.empty() && std::all_of(color.begin(), color.end(), [](unsigned char character)
+                                                                                                  { return (std::isalnum(character) || std::string(" #(),.%-").find(static_cast<char>(character)) != std::string::npos); }));
+            color_style = "<template shadowrootmode=\"closed\"><style>:host{color:" + color + "!important}</style><slot></slot></template>";
+        }
+        if (valid)
+        {
+            std::string lines;
+            std::size_t start = 0;
+            for (std::size_t end = text.find('\n'); end != std::string::npos; start = end + 1, end = text.find('\n', start))
+                lines += escape_html(text.substr(start, end - start)) + "<br>";
+            lines += escape_html(text.substr(start));
+            std::string const element = (type == "text" ? "span" : "h2");
+            markup = "<" + element + " class=\"" + type + "\" align=\"" + horizontal + "\" valign=\"" + vertical + "\" prerendered>" + color_style + lines + "</" + element + ">";
+        }
+    }
+    rendering.erase(name);
+    return markup;
+}
+
+std::string structure_t::prerender() const
+{
+    std::set<widget_name_t> rendering = {};
+    std::string const markup = prerender_widget("main", rendering);
+    m_logger.info(m_name, "Pre-rendered ", markup.size(), " byte(s) of static markup");
+    return markup;
+}
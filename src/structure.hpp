@@ -1,9 +1,14 @@
 #pragma once
 
+#include "cache.hpp"
+#include "logging.hpp"
+
 #include <filesystem>
 #include <fstream>
 #include <string>
 #include <map>
+#include <nlohmann/json.hpp>
+#include <set>
 #include <vector>
 #include <yaml-cpp/yaml.h>
 
@@ -44,14 +49,26 @@ namespace sss::guis
          * @brief Collection of already parsed files
          */
         std::set<std::filesystem::path> m_parsed_files;
+        /**
+         * @brief Whether object references were converted to numeric values when built
+         */
+        bool m_numeric_references;
         /**
          * @brief The name of this structure (only used for debug output)
          */
         std::string const m_name;
         /**
-         * @brief Output stream for debug messages
+         * @brief Logger for debug messages
+         */
+        logger_t &m_logger;
+        /**
+         * @brief Persistent cache of parsed configuration files
+         */
+        cache_t const &m_cache;
+        /**
+         * @brief The input to read configuration files from
          */
-        std::ostream *m_debug_stream;
+        input_t const &m_input;
 
         /**
          * @brief Parse a YAML file, handling dependencies and widgets
@@ -73,15 +90,43 @@ namespace sss::guis
          * @brief Remove all unreferenced objects
          */
         void prune_references();
+        /**
+         * @brief Order the widgets reachable from `main` so that every widget comes before the widgets it references
+         * @param depth The length of the longest chain of references from `main`
+         * @return Names of the reachable widgets (in instantiation order, starting with `main`)
+         * @throw std::runtime_error If widgets reference each other in a cycle (giving the path of references from `main`)
+         */
+        std::vector<widget_name_t> instantiation_order(std::size_t &depth) const;
+        /**
+         * @brief Minify built widget configurations by interning object keys into a key dictionary (`keys`) and replacing repeated subtrees with references to a shared table (`shared`)
+         * @param structure The built structure (with numeric references)
+         */
+        void minify(nlohmann::json &structure) const;
+        /**
+         * @brief Resolve an object reference to the name of a widget
+         * @param reference The object reference (either a name or a numeric value)
+         * @param name The name of the referenced widget
+         * @return Whether the reference relates to a known widget
+         */
+        bool resolve_reference(YAML::Node const &reference, widget_name_t &name) const;
+        /**
+         * @brief Render the static markup of a widget ahead of time
+         * @param name The name of the widget to render
+         * @param rendering Names of the widgets currently being rendered (to guard against recursive references)
+         * @return HTML markup of the widget (or an empty placeholder if it can only be rendered at runtime)
+         */
+        std::string prerender_widget(widget_name_t const &name, std::set<widget_name_t> &rendering) const;
 
     public:
         /**
          * @brief Construct a structure parser object that parsers YAML files into a JSON object
          * @param configuration_file The source configuration file to start structuring from
          * @param name The name of the structure (only used for debug output)
-         * @param debug_stream A `std::ofstream` to write debug outputs to
+         * @param logger The logger to write debug outputs to
+         * @param input The input to read configuration files from
+         * @param cache Persistent cache of parsed configuration files
          */
-        structure_t(std::string const &configuration_file, std::string const &name, std::ostream const *debug_stream = nullptr);
+        structure_t(std::string const &configuration_file, std::string const &name, logger_t &logger, input_t const &input, cache_t const &cache);
         /**
          * @brief Deconstructor
          */
@@ -91,5 +136,27 @@ namespace sss::guis
          * @param debug_references Whether to convert object references to a numeric value
          */
         std::string build(bool const numeric_references = true);
+        /**
+         * @brief Collect the asset paths referenced by the widgets reachable from `main`
+         * @param properties Names of additional properties (of any widget) whose values are asset paths, besides the `source` of `image`, `audio`, and `video` widgets
+         * @return Referenced asset paths (as written in the widget configurations)
+         */
+        std::set<std::string> references(std::vector<std::string> const &properties) const;
+        /**
+         * @brief Count the widgets of the built structure by type
+         * @return Amount of widgets of each type
+         */
+        std::map<widget_type_t, std::size_t> widget_type_counts() const;
+        /**
+         * @brief Collect the types of the widgets nearest to `main`
+         * @param levels How many levels of references to follow (1 for only `main`, 2 for `main` and its children, and so on)
+         * @return Types of the widgets within `levels` of `main`
+         */
+        std::set<widget_type_t> top_level_types(std::size_t const levels) const;
+        /**
+         * @brief Render the static widgets of the built structure into HTML, which the runtime hydrates rather than rebuilds
+         * @return HTML markup of the `main` widget
+         */
+        std::string prerender() const;
     };
 }
@@ -0,0 +1,475 @@
+#include "stylesheet.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+using namespace sss::guis;
+
+namespace
+{
+    /**
+     * @brief Check whether text starts with a keyword at a position (ignoring case)
+     * @param text The text to check
+     * @param position The position of the keyword
+     * @param keyword The keyword (in lowercase)
+     * @return Whether the keyword is at the position
+     */
+    bool keyword_at(std::string const &text, std::size_t const position, std::string const &keyword)
+    {
+        if (position + keyword.size() > text.size())
+            return false;
+        for (std::size_t i = 0; i < keyword.size(); ++i)
+        {
+            if (std::tolower(static_cast<unsigned char>(text[position + i])) != keyword[i])
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Check whether a character can be part of an identifier
+     * @param character The character to check
+     * @return Whether it can be part of an identifier
+     */
+    bool identifier_character(char const character)
+    {
+        return (std::isalnum(static_cast<unsigned char>(character)) || character == '-' || character == '_' || static_cast<unsigned char>(character) >= 0x80);
+    }
+
+    /**
+     * @brief Remove leading and trailing whitespace
+     * @param text The text to trim
+     * @return The trimmed text
+     */
+    std::string trim(std::string const &text)
+    {
+        std::size_t const start = text.find_first_not_of(" \t\r\n\f");
+        if (start == std::string::npos)
+            return "";
+        return text.substr(start, text.find_last_not_of(" \t\r\n\f") - start + 1);
+    }
+
+    /**
+     * @brief Find the end of a string
+     * @param text The text holding the string
+     * @param open The position of the opening quote
+     * @return The position after the closing quote
+     */
+    std::size_t string_end(std::string const &text, std::size_t const open)
+    {
+        char const quote = text[open];
+        std::size_t position = open + 1;
+        while (position < text.size() && text[position] != quote)
+            position += (text[position] == '\\' ? 2 : 1);
+        return std::min(position + 1, text.size());
+    }
+
+    /**
+     * @brief Check whether a comment starts at a position
+     * @param text The text to check
+     * @param position The position to check
+     * @return Whether a comment starts at the position
+     */
+    bool comment_at(std::string const &text, std::size_t const position)
+    {
+        return (text.compare(position, 2, "/*") == 0);
+    }
+
+    /**
+     * @brief Find the end of a comment
+     * @param text The text holding the comment
+     * @param open The position of the comment
+     * @return The position after the comment
+     */
+    std::size_t comment_end(std::string const &text, std::size_t const open)
+    {
+        std::size_t const close = text.find("*/", open + 2);
+        return (close == std::string::npos ? text.size() : close + 2);
+    }
+
+    /**
+     * @brief Find the first of some characters that is not within a string, comment, parentheses, or brackets
+     * @param text The text to search
+     * @param position The position to search from
+     * @param characters The characters to find
+     * @return The position of the character (or `std::string::npos` if not found)
+     */
+    std::size_t find_outside(std::string const &text, std::size_t position, std::string const &characters)
+    {
+        std::size_t depth = 0;
+        while (position < text.size())
+        {
+            char const character = text[position];
+            if (character == '"' || character == '\'')
+            {
+                position = string_end(text, position);
+                continue;
+            }
+            if (comment_at(text, position))
+            {
+                position = comment_end(text, position);
+                continue;
+            }
+            if (depth == 0 && characters.find(character) != std::string::npos)
+                return position;
+            if (character == '(' || character == '[')
+                depth++;
+            else if ((character == ')' || character == ']') && depth > 0)
+                depth--;
+            position++;
+        }
+        return std::string::npos;
+    }
+
+    /**
+     * @brief Find the end of a block
+     * @param text The text holding the block
+     * @param open The position of the opening brace
+     * @return The position of the matching closing brace (or the end of the text if unmatched)
+     */
+    std::size_t block_end(std::string const &text, std::size_t const open)
+    {
+        std::size_t depth = 0;
+        std::size_t position = open;
+        while (position < text.size())
+        {
+            char const character = text[position];
+            if (character == '"' || character == '\'')
+            {
+                position = string_end(text, position);
+                continue;
+            }
+            if (comment_at(text, position))
+            {
+                position = comment_end(text, position);
+                continue;
+            }
+            if (character == '{')
+                depth++;
+            else if (character == '}' && --depth == 0)
+                return position;
+            position++;
+        }
+        return text.size();
+    }
+
+    /**
+     * @brief Check whether a reference is to a file relative to the stylesheet (rather than a URL with a scheme, an absolute path, or a fragment)
+     * @param url The reference
+     * @return Whether the reference is relative
+     */
+    bool relative_reference(std::string const &url)
+    {
+        if (url.empty() || url.front() == '/' || url.front() == '#')
+            return false;
+        std::size_t const scheme = url.find(':');
+        return (scheme == std::string::npos || scheme > url.find_first_of("/?#"));
+    }
+
+    /**
+     * @brief Make a relative reference relative to another directory
+     * @param url The reference
+     * @param from The directory that the reference is relative to
+     * @param to The directory that the reference should be relative to
+     * @return The rebased reference (or the reference itself if it is not relative)
+     */
+    std::string rebase_reference(std::string const &url, std::filesystem::path const &from, std::filesystem::path const &to)
+    {
+        if (!relative_reference(url))
+            return url;
+        std::size_t const suffix = url.find_first_of("?#");
+        std::filesystem::path const rebased = (from / url.substr(0, suffix)).lexically_normal().lexically_relative(to.lexically_normal());
+        if (rebased.empty())
+            return url;
+        return rebased.generic_string() + (suffix == std::string::npos ? "" : url.substr(suffix));
+    }
+
+    /**
+     * @brief Make the `url()` references of a stylesheet relative to another directory
+     * @param stylesheet The stylesheet
+     * @param from The directory that the references are relative to
+     * @param to The directory that the references should be relative to
+     * @return The stylesheet with rebased references
+     */
+    std::string rebase_urls(std::string const &stylesheet, std::filesystem::path const &from, std::filesystem::path const &to)
+    {
+        std::string rebased;
+        std::size_t copied = 0;
+        std::size_t position = 0;
+        while (position < stylesheet.size())
+        {
+            char const character = stylesheet[position];
+            if (character == '"' || character == '\'')
+            {
+                position = string_end(stylesheet, position);
+                continue;
+            }
+            if (comment_at(stylesheet, position))
+            {
+                position = comment_end(stylesheet, position);
+                continue;
+            }
+            if (!keyword_at(stylesheet, position, "url(") || (position > 0 && identifier_character(stylesheet[position - 1])))
+            {
+                position++;
+                continue;
+            }
+            std::size_t start = position + 4;
+            while (start < stylesheet.size() && std::isspace(static_cast<unsigned char>(stylesheet[start])))
+                start++;
+            std::string quote;
+            std::string url;
+            std::size_t end = start;
+            if (start < stylesheet.size() && (stylesheet[start] == '"' || stylesheet[start] == '\''))
+            {
+                quote = stylesheet[start];
+                end = string_end(stylesheet, start);
+                url = stylesheet.substr(start + 1, end - start - 2);
+            }
+            std::size_t const close = stylesheet.find(')', end);
+            if (close == std::string::npos)
+                break;
+            if (quote.empty())
+                url = trim(stylesheet.substr(start, close - start));
+            rebased.append(stylesheet, copied, position - copied);
+            rebased += "url(" + quote + rebase_reference(url, from, to) + quote + ")";
+            position = copied = close + 1;
+        }
+        rebased.append(stylesheet, copied, std::string::npos);
+        return rebased;
+    }
+
+    /**
+     * @brief Flatten the local stylesheets that a stylesheet imports into it
+     * @param file The absolute path of the stylesheet
+     * @param root_directory The directory of the stylesheet being built (that `url()` references are made relative to)
+     * @param input The input to read stylesheets from
+     * @param importing The stylesheets currently being flattened (to guard against cyclic imports)
+     * @param imports Imports that are kept (remote, or with conditions that cannot be expressed by wrapping), as they must precede every rule
+     * @return The flattened stylesheet (without the kept imports)
+     */
+    std::string flatten_imports(std::filesystem::path const &file, std::filesystem::path const &root_directory, input_t const &input, std::vector<std::filesystem::path> &importing, std::string &imports)
+    {
+        if (std::find(importing.begin(), importing.end(), file) != importing.end())
+        {
+            std::string cycle;
+            for (auto imported = std::find(importing.begin(), importing.end(), file); imported != importing.end(); ++imported)
+                cycle += "\"" + imported->string() + "\" -> ";
+            throw std::runtime_error("Stylesheets import each other in a cycle: " + cycle + "\"" + file.string() + "\"");
+        }
+        input_status_t const status = input.status(file);
+        if (!status.exists || status.directory)
+            throw std::runtime_error("Unable to find the imported stylesheet \"" + file.string() + "\"");
+        importing.push_back(file);
+        std::string const stylesheet = input.read(file);
+        std::filesystem::path const directory = file.parent_path();
+
+        // Imports can only precede every other rule (besides `@charset`)
+        std::string flattened;
+        std::size_t position = 0;
+        while (true)
+        {
+            while (position < stylesheet.size() && (std::isspace(static_cast<unsigned char>(stylesheet[position])) || comment_at(stylesheet, position)))
+                position = (comment_at(stylesheet, position) ? comment_end(stylesheet, position) : position + 1);
+            bool const charset = keyword_at(stylesheet, position, "@charset");
+            if (!charset && !keyword_at(stylesheet, position, "@import"))
+                break;
+            std::size_t const end = find_outside(stylesheet, position, ";");
+            if (end == std::string::npos)
+                break;
+            std::string const statement = trim(stylesheet.substr(position, end - position));
+            position = end + 1;
+            if (charset)
+                continue; // Published stylesheets are UTF-8 (like the HTML files that use them)
+
+            std::string const target = trim(statement.substr(7));
+            std::string url;
+            std::size_t after = 0;
+            if (!target.empty() && (target.front() == '"' || target.front() == '\''))
+            {
+                after = string_end(target, 0);
+                url = target.substr(1, after - 2);
+            }
+            else if (keyword_at(target, 0, "url("))
+            {
+                after = find_outside(target, 4, ")");
+                if (after == std::string::npos)
+                    after = target.size();
+                url = trim(target.substr(4, after - 4));
+                if (!url.empty() && (url.front() == '"' || url.front() == '\''))
+                    url = url.substr(1, string_end(url, 0) - 2);
+                after++;
+            }
+            else
+            {
+                imports += statement + ";";
+                continue;
+            }
+            std::string const conditions = trim(target.substr(std::min(after, target.size())));
+            bool const media_conditions = !conditions.empty() && !keyword_at(conditions, 0, "layer") && !keyword_at(conditions, 0, "supports");
+            if (!relative_reference(url) || (!conditions.empty() && !media_conditions))
+            {
+                imports += "@import url(\"" + rebase_reference(url, directory, root_directory) + "\")" + (conditions.empty() ? "" : " " + conditions) + ";";
+                continue;
+            }
+            std::string const imported = flatten_imports((directory / url.substr(0, url.find_first_of("?#"))).lexically_normal(), root_directory, input, importing, imports);
+            flattened += (media_conditions ? "@media " + conditions + "{" + imported + "}" : imported);
+        }
+        flattened += rebase_urls(stylesheet.substr(position), directory, root_directory);
+        importing.pop_back();
+        return flattened;
+    }
+
+    /**
+     * @brief Get the class names that a selector uses
+     * @param selector The selector
+     * @return The class names
+     */
+    std::vector<std::string> selector_classes(std::string const &selector)
+    {
+        std::vector<std::string> classes = {};
+        std::size_t brackets = 0;
+        std::size_t position = 0;
+        while (position < selector.size())
+        {
+            char const character = selector[position];
+            if (character == '"' || character == '\'')
+            {
+                position = string_end(selector, position);
+                continue;
+            }
+            if (character == '[')
+                brackets++;
+            else if (character == ']' && brackets > 0)
+                brackets--;
+            else if (character == '.' && brackets == 0)
+            {
+                std::string name;
+                for (position++; position < selector.size() && (identifier_character(selector[position]) || selector[position] == '\\'); position++)
+                {
+                    if (selector[position] == '\\' && position + 1 < selector.size())
+                        name += selector[position++];
+                    name += selector[position];
+                }
+                classes.push_back(name);
+                continue;
+            }
+            position++;
+        }
+        return classes;
+    }
+
+    /**
+     * @brief Keep the rules of a (minified) stylesheet that can apply to the top-level widgets
+     * @param stylesheet The stylesheet
+     * @param classes The class names of the top-level widgets
+     * @return The kept rules
+     */
+    std::string critical_rules(std::string const &stylesheet, std::set<std::string> const &classes)
+    {
+        std::string kept;
+        std::size_t position = 0;
+        while (position < stylesheet.size())
+        {
+            std::size_t const end = find_outside(stylesheet, position, "{;");
+            if (end == std::string::npos)
+                break;
+            std::string const prelude = trim(stylesheet.substr(position, end - position));
+            if (stylesheet[end] == ';')
+            {
+                position = end + 1; // Statements (such as remote imports) are left to the stylesheet
+                continue;
+            }
+            std::size_t const close = block_end(stylesheet, end);
+            std::string const block = stylesheet.substr(end + 1, close - end - 1);
+            position = close + 1;
+            if (!prelude.empty() && prelude.front() == '@')
+            {
+                std::string name = prelude.substr(1, prelude.find_first_of(" ({") - 1);
+                std::transform(name.begin(), name.end(), name.begin(), [](unsigned char character)
+                               { return static_cast<char>(std::tolower(character)); });
+                if (name == "font-face")
+                    kept += prelude + "{" + block + "}";
+                else if (name == "media" || name == "supports" || name == "layer" || name == "container")
+                {
+                    std::string const inner = critical_rules(block, classes);
+                    if (!inner.empty())
+                        kept += prelude + "{" + inner + "}";
+                }
+                continue;
+            }
+            for (std::size_t start = 0; start <= prelude.size();)
+            {
+                std::size_t const separator = std::min(find_outside(prelude, start, ","), prelude.size());
+                std::vector<std::string> const used = selector_classes(prelude.substr(start, separator - start));
+                if (std::all_of(used.begin(), used.end(), [&classes](std::string const &name)
+                                { return classes.count(name) > 0; }))
+                {
+                    kept += prelude + "{" + block + "}";
+                    break;
+                }
+                start = separator + 1;
+            }
+        }
+        return kept;
+    }
+}
+
+std::string sss::guis::build_stylesheet(std::filesystem::path const &file, input_t const &input)
+{
+    std::vector<std::filesystem::path> importing = {};
+    std::string imports;
+    std::filesystem::path const normal = file.lexically_normal();
+    std::string const flattened = flatten_imports(normal, normal.parent_path(), input, importing, imports);
+    return minify_stylesheet(imports + flattened);
+}
+
+std::string sss::guis::minify_stylesheet(std::string const &stylesheet)
+{
+    // Whitespace next to these is never significant (unlike around `+`, `-`, or before `(` and `:`)
+    std::string const unspaced_before = "{};,>)!";
+    std::string const unspaced_after = "{};,>(:";
+
+    std::string minified;
+    minified.reserve(stylesheet.size());
+    bool space = false;
+    std::size_t position = 0;
+    while (position < stylesheet.size())
+    {
+        char const character = stylesheet[position];
+        if (comment_at(stylesheet, position))
+        {
+            position = comment_end(stylesheet, position);
+            continue;
+        }
+        if (std::isspace(static_cast<unsigned char>(character)))
+        {
+            space = true;
+            position++;
+            continue;
+        }
+        if (space && !minified.empty() && unspaced_after.find(minified.back()) == std::string::npos && unspaced_before.find(character) == std::string::npos)
+            minified += ' ';
+        space = false;
+        if (character == '"' || character == '\'')
+        {
+            std::size_t const end = string_end(stylesheet, position);
+            minified.append(stylesheet, position, end - position);
+            position = end;
+            continue;
+        }
+        if (character == '}' && !minified.empty() && minified.back() == ';')
+            minified.pop_back();
+        minified += character;
+        position++;
+    }
+    return minified;
+}
+
+std::string sss::guis::critical_stylesheet(std::string const &stylesheet, std::set<std::string> const &classes, std::filesystem::path const &stylesheet_directory, std::filesystem::path const &document_directory)
+{
+    return rebase_urls(critical_rules(stylesheet, classes), stylesheet_directory, document_directory);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "input.hpp"
+
+#include <filesystem>
+#include <set>
+#include <string>
+
+namespace sss::guis
+{
+    /**
+     * @brief Build a stylesheet for publishing, flattening the local stylesheets it imports into it (rebasing their `url()` references) and minifying it
+     * @param file The absolute path of the stylesheet
+     * @param input The input to read the stylesheet (and the stylesheets it imports) from
+     * @return The built stylesheet
+     * @throw std::runtime_error If an imported stylesheet cannot be found, or stylesheets import each other in a cycle
+     */
+    std::string build_stylesheet(std::filesystem::path const &file, input_t const &input);
+
+    /**
+     * @brief Minify a stylesheet (removing comments and any whitespace that does not change its meaning)
+     * @param stylesheet The stylesheet to minify
+     * @return The minified stylesheet
+     */
+    std::string minify_stylesheet(std::string const &stylesheet);
+
+    /**
+     * @brief Extract the rules of a built stylesheet that can apply to the top-level widgets, to be inlined into an HTML file so that its first render is styled
+     *
+     * A rule is kept when one of its selectors only uses class names of `classes` (selectors without class names are kept as they may apply to the document itself), along with any `@font-face` rules and the kept rules of conditional group rules (such as `@media`)
+     * @param stylesheet The built stylesheet
+     * @param classes The class names of the top-level widgets (their types)
+     * @param stylesheet_directory The directory of the stylesheet within the output (that its `url()` references are relative to)
+     * @param document_directory The directory of the HTML file within the output (that inlined `url()` references are made relative to)
+     * @return The critical rules
+     */
+    std::string critical_stylesheet(std::string const &stylesheet, std::set<std::string> const &classes, std::filesystem::path const &stylesheet_directory, std::filesystem::path const &document_directory);
+}
@@ -0,0 +1,147 @@
+#include "templates.hpp"
+
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+using namespace sss::guis;
+
+namespace
+{
+    /**
+     * @brief Get the value of a template parameter
+     * @param node The YAML node of the value
+     * @param name The name of the parameter
+     * @returns The value
+     */
+    std::string parameter_value(YAML::Node const &node, std::string const &name)
+    {
+        if (name.empty() || name.find_first_of("{}") != std::string::npos)
+            throw std::runtime_error("Invalid template parameter name \"" + name + "\"");
+        if (!node.IsScalar())
+            throw std::runtime_error("The value of template parameter `" + name + "` must be a scalar");
+        return node.Scalar();
+    }
+}
+
+std::string sss::guis::escape_html(std::string const &text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char const character : text)
+    {
+        switch (character)
+        {
+        case '&':
+            escaped += "&amp;";
+            break;
+        case '<':
+            escaped += "&lt;";
+            break;
+        case '>':
+            escaped += "&gt;";
+            break;
+        case '"':
+            escaped += "&quot;";
+            break;
+        case '\'':
+            escaped += "&#39;";
+            break;
+        default:
+            escaped += character;
+        }
+    }
+    return escaped;
+}
+
+std::string sss::guis::substitute_parameters(std::string const &text, parameters_t const &parameters, escape_t const escape)
+{
+    if (parameters.empty())
+        return text;
+    std::string substituted;
+    substituted.reserve(text.size());
+    std::size_t position = 0;
+    for (std::size_t open = text.find("{{"); open != std::string::npos; open = text.find("{{", position))
+    {
+        std::size_t const close = text.find("}}", open + 2);
+        if (close == std::string::npos)
+            break;
+        substituted.append(text, position, open - position);
+        auto const parameter = parameters.find(text.substr(open + 2, close - open - 2));
+        if (parameter == parameters.end())
+            substituted.append(text, open, close + 2 - open);
+        else if (escape == escape_t::json)
+        {
+            std::string const quoted = nlohmann::json(parameter->second).dump();
+            substituted.append(quoted, 1, quoted.size() - 2);
+        }
+        else if (escape == escape_t::html)
+            substituted += escape_html(parameter->second);
+        else
+            substituted += parameter->second;
+        position = close + 2;
+    }
+    substituted.append(text, position, std::string::npos);
+    return substituted;
+}
+
+void sss::guis::substitute_parameters(YAML::Node node, parameters_t const &parameters)
+{
+    if (node.IsScalar())
+        node = substitute_parameters(node.Scalar(), parameters);
+    else if (node.IsMap())
+    {
+        for (auto entry : node)
+            substitute_parameters(entry.second, parameters);
+    }
+    else if (node.IsSequence())
+    {
+        for (auto item : node)
+            substitute_parameters(item, parameters);
+    }
+}
+
+std::vector<parameters_t> sss::guis::template_instances(YAML::Node const &node)
+{
+    std::vector<parameters_t> instances = {};
+    if (node.IsSequence())
+    {
+        for (YAML::Node const &instance : node)
+        {
+            if (!instance.IsMap())
+                throw std::runtime_error("Each instance of a template's `parameters` must be a mapping of parameter values");
+            parameters_t parameters = {};
+            for (auto const &parameter : instance)
+            {
+                std::string const name = parameter.first.as<std::string>();
+                parameters[name] = parameter_value(parameter.second, name);
+            }
+            instances.push_back(parameters);
+        }
+    }
+    else if (node.IsMap())
+    {
+        // Every combination of the listed values
+        instances.push_back({});
+        for (auto const &parameter : node)
+        {
+            std::string const name = parameter.first.as<std::string>();
+            if (!parameter.second.IsSequence())
+                throw std::runtime_error("The values of template parameter `" + name + "` must be a list");
+            std::vector<parameters_t> combinations = {};
+            for (auto const &instance : instances)
+            {
+                for (YAML::Node const &value : parameter.second)
+                {
+                    combinations.push_back(instance);
+                    combinations.back()[name] = parameter_value(value, name);
+                }
+            }
+            instances = combinations;
+        }
+    }
+    else
+        throw std::runtime_error("Unable to parse `parameters` since a list of instances or a mapping of values is expected");
+    if (instances.empty())
+        throw std::runtime_error("A template GUI has no instances in its `parameters`");
+    return instances;
+}
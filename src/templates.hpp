@@ -0,0 +1,54 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+namespace sss::guis
+{
+    /**
+     * @brief Values of template parameters (keyed by parameter name)
+     */
+    using parameters_t = std::map<std::string, std::string>;
+
+    /**
+     * @brief How a parameter value is escaped when substituted
+     */
+    enum class escape_t
+    {
+        none,
+        json,
+        html
+    };
+
+    /**
+     * @brief Escape text for use within HTML content or attribute values
+     * @param text The text to escape
+     * @return Escaped text
+     */
+    std::string escape_html(std::string const &text);
+
+    /**
+     * @brief Replace `{{name}}` placeholders with the values of parameters (placeholders of unknown parameters are kept)
+     * @param text The text to substitute parameters into
+     * @param parameters The values of parameters
+     * @param escape How values are escaped for the context of `text` (`json` for within JSON strings)
+     * @return The substituted text
+     */
+    std::string substitute_parameters(std::string const &text, parameters_t const &parameters, escape_t const escape = escape_t::none);
+
+    /**
+     * @brief Substitute parameters into every scalar of a YAML node
+     * @param node The node to substitute parameters into (modified in place)
+     * @param parameters The values of parameters
+     */
+    void substitute_parameters(YAML::Node node, parameters_t const &parameters);
+
+    /**
+     * @brief Get the parameters of each instance of a template GUI
+     * @param node The `parameters` of the GUI; either a list of instances (each a mapping of parameter values), or a mapping of parameters to lists of values (expanded to every combination)
+     * @return The parameter values of each instance
+     */
+    std::vector<parameters_t> template_instances(YAML::Node const &node);
+}